@@ -71,6 +71,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - fix: forgot to comment out the EVE2 BITMAP_TRANSFORM_E when converting it to an inline function
 - replaced the last function-like macro with a static inline function: EVE_PIPS(n)
 - Compliance: fixed BARR-C:2018 Rule 1.8b violations
+- fix: BITMAP_SOURCE() cut off bit 23 which selects the flash of BT81x
 
 */
 
@@ -682,14 +683,15 @@ static inline uint32_t BITMAP_SIZE_H(const uint16_t width, const uint16_t height
     return ((DL_BITMAP_SIZE_H) | widthv | heightv);
 }
 
-//#define BITMAP_SOURCE(addr) ((DL_BITMAP_SOURCE) | ((addr) & 0x3FFFFFUL))
+//#define BITMAP_SOURCE(addr) ((DL_BITMAP_SOURCE) | ((addr) & 0xFFFFFFUL))
 /**
  * @brief Set the source address of bitmap data in RAM_G or flash memory.
+ * @note With BT81x bit 23 selects the flash, the address is in units of 32 bytes then.
  * @return a 32 bit word for use with EVE_cmd_dl()
  */
 static inline uint32_t BITMAP_SOURCE(const uint32_t addr)
 {
-    return (DL_BITMAP_SOURCE | (addr & 0x3FFFFFUL));
+    return (DL_BITMAP_SOURCE | (addr & 0xFFFFFFUL));
 }
 
 #if EVE_GEN < 3 /* only define these for FT81x */
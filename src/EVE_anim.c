@@ -0,0 +1,204 @@
+/*
+@file    EVE_anim.c
+@brief   manager for the animation channels of BT817 / BT818
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+EVE plays up to 32 animations at the same time, each one on its own channel.
+This keeps track of which channel is in use, the channels that finished are found with a single
+read of REG_ANIM_ACTIVE per frame and are free for the next animation, no matter how many are running.
+
+The start, move, stop and draw functions add the commands to the display list that is built,
+with and without burst-mode. EVE_anim_update() reads a register and needs to be called
+before the display list is started:
+
+EVE_anim_update();
+EVE_start_cmd_burst();
+EVE_cmd_dl_burst(CMD_DLSTART);
+...
+if (button_pressed)
+{
+    (void) EVE_anim_start(ANIM_ADDRESS, EVE_ANIM_ONCE, EVE_ANIM_FLASH, 100, 100);
+}
+EVE_anim_draw();
+...
+
+Animations that are started with EVE_ANIM_HOLD keep their channel and are drawn with the last
+frame until EVE_anim_stop().
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#include "EVE_anim.h"
+
+#if EVE_GEN > 3
+
+#define ANIM_MASK ((EVE_ANIM_CHANNELS < 32U) ? ((1UL << EVE_ANIM_CHANNELS) - 1UL) : 0xFFFFFFFFUL)
+
+static uint32_t anim_used = 0UL;
+static uint32_t anim_hold = 0UL;
+static uint32_t anim_fresh = 0UL; /* started after the last EVE_anim_update(), not in REG_ANIM_ACTIVE yet */
+static uint32_t anim_active = 0UL;
+
+/**
+ * @brief Start an animation on a free channel.
+ * @param aoptr address of the animation object in flash or in RAM_G
+ * @param loop EVE_ANIM_ONCE, EVE_ANIM_LOOP or EVE_ANIM_HOLD
+ * @param source EVE_ANIM_FLASH or EVE_ANIM_RAM_G
+ * @return the channel or EVE_ANIM_NO_CHANNEL when all are in use
+ * @note Works with and without burst-mode.
+ */
+uint8_t EVE_anim_start(uint32_t aoptr, uint32_t loop, uint8_t source, int16_t xc0, int16_t yc0)
+{
+    uint8_t ret = EVE_ANIM_NO_CHANNEL;
+
+    for (uint8_t chnl = 0U; chnl < EVE_ANIM_CHANNELS; chnl++)
+    {
+        uint32_t const bit = 1UL << chnl;
+
+        if (0UL == (anim_used & bit))
+        {
+            if (EVE_ANIM_RAM_G == source)
+            {
+                EVE_cmd_animstartram((int32_t) chnl, aoptr, loop);
+            }
+            else
+            {
+                EVE_cmd_animstart((int32_t) chnl, aoptr, loop);
+            }
+            EVE_cmd_animxy((int32_t) chnl, xc0, yc0);
+
+            anim_used |= bit;
+            anim_fresh |= bit;
+            if (EVE_ANIM_HOLD == loop)
+            {
+                anim_hold |= bit;
+            }
+            else
+            {
+                anim_hold &= ~bit;
+            }
+            ret = chnl;
+            break;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Move a running animation.
+ * @note Works with and without burst-mode.
+ */
+void EVE_anim_move(uint8_t chnl, int16_t xc0, int16_t yc0)
+{
+    if ((chnl < EVE_ANIM_CHANNELS) && ((anim_used & (1UL << chnl)) != 0UL))
+    {
+        EVE_cmd_animxy((int32_t) chnl, xc0, yc0);
+    }
+}
+
+/**
+ * @brief Stop an animation and free its channel.
+ * @note Works with and without burst-mode.
+ */
+void EVE_anim_stop(uint8_t chnl)
+{
+    if ((chnl < EVE_ANIM_CHANNELS) && ((anim_used & (1UL << chnl)) != 0UL))
+    {
+        EVE_cmd_animstop((int32_t) chnl);
+        anim_used &= ~(1UL << chnl);
+        anim_hold &= ~(1UL << chnl);
+        anim_fresh &= ~(1UL << chnl);
+    }
+}
+
+/**
+ * @brief Read REG_ANIM_ACTIVE once and free the channels of the animations that finished.
+ * @note Call this once per frame, before the display list is started.
+ * @note Does nothing while a DMA transfer is active.
+ * @return the number of channels in use
+ */
+uint8_t EVE_anim_update(void)
+{
+    uint8_t count = 0U;
+
+#if defined (EVE_DMA)
+    if (0 == EVE_dma_busy)
+    {
+#endif
+    anim_active = EVE_memRead32(REG_ANIM_ACTIVE) & ANIM_MASK;
+
+    /* channels that are neither playing nor holding their last frame nor just started */
+    anim_used &= anim_active | anim_hold | anim_fresh;
+    anim_fresh = 0UL;
+#if defined (EVE_DMA)
+    }
+#endif
+
+    for (uint32_t used = anim_used; used != 0UL; used &= used - 1UL)
+    {
+        count++;
+    }
+    return (count);
+}
+
+/**
+ * @brief Add CMD_ANIMDRAW for every channel in use to the display list.
+ * @note Works with and without burst-mode.
+ */
+void EVE_anim_draw(void)
+{
+    for (uint8_t chnl = 0U; chnl < EVE_ANIM_CHANNELS; chnl++)
+    {
+        if ((anim_used & (1UL << chnl)) != 0UL)
+        {
+            EVE_cmd_animdraw((int32_t) chnl);
+        }
+    }
+}
+
+/**
+ * @brief Check if a channel is in use, as of the last EVE_anim_update().
+ */
+uint8_t EVE_anim_is_active(uint8_t chnl)
+{
+    uint8_t ret = 0U;
+
+    if ((chnl < EVE_ANIM_CHANNELS) && ((anim_used & (1UL << chnl)) != 0UL))
+    {
+        ret = 1U;
+    }
+    return (ret);
+}
+
+#endif /* EVE_GEN > 3 */
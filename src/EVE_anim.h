@@ -0,0 +1,82 @@
+/*
+@file    EVE_anim.h
+@brief   manager for the animation channels of BT817 / BT818
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_ANIM_H
+#define EVE_ANIM_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if EVE_GEN > 3
+
+/* you may define these in your build-environment to use different settings */
+#if !defined (EVE_ANIM_CHANNELS)
+#define EVE_ANIM_CHANNELS 32U /* channels 0...EVE_ANIM_CHANNELS-1 are managed, the rest is free for other uses */
+#endif
+
+#if (EVE_ANIM_CHANNELS < 1U) || (EVE_ANIM_CHANNELS > 32U)
+#error "EVE_ANIM_CHANNELS needs to be 1...32"
+#endif
+
+#define EVE_ANIM_ONCE 0UL
+#define EVE_ANIM_LOOP 1UL
+#define EVE_ANIM_HOLD 2UL
+
+#define EVE_ANIM_FLASH 0U
+#define EVE_ANIM_RAM_G 1U
+
+#define EVE_ANIM_NO_CHANNEL 0xFFU
+
+uint8_t EVE_anim_start(uint32_t aoptr, uint32_t loop, uint8_t source, int16_t xc0, int16_t yc0);
+void EVE_anim_move(uint8_t chnl, int16_t xc0, int16_t yc0);
+void EVE_anim_stop(uint8_t chnl);
+uint8_t EVE_anim_update(void);
+void EVE_anim_draw(void);
+uint8_t EVE_anim_is_active(uint8_t chnl);
+
+#endif /* EVE_GEN > 3 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_ANIM_H */
@@ -0,0 +1,203 @@
+/*
+@file    EVE_audio.c
+@brief   streaming audio playback thru a looping ring buffer in RAM_G
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+Playing a sample with REG_PLAYBACK_* needs the whole sample in RAM_G.
+Here the sample is streamed instead: the ring buffer in RAM_G is played in a loop and
+split into two halves, when REG_PLAYBACK_READPTR moved on to the other half the half that
+was just played is refilled from the source callback.
+EVE_audio_service() needs to be called at least once for every half that is played,
+for a ring of 4096 bytes with 8 kHz u-law samples that is every 256ms.
+
+When the source reports the end of the stream the rest is filled with silence and the
+playback is stopped after the last half with samples was played.
+
+EVE_audio_play(MEM_AUDIO, 4096UL, EVE_ULAW_SAMPLES, 8000U, 0xFFU, read_from_sd);
+...
+(void) EVE_audio_service();
+
+@section History
+
+5.0
+- initial version
+- fix: EVE_audio_play() rejects a ring that is not 8 byte aligned instead of moving it
+
+*/
+
+#include "EVE_audio.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+#define AUDIO_NO_END 0xFFU
+
+static EVE_media_source audio_source = NULL;
+static uint32_t audio_address = 0UL;
+static uint32_t audio_half = 0UL; /* size of one half of the ring */
+static uint8_t audio_silence = 0U;
+static uint8_t audio_playing_half = 0U;
+static uint8_t audio_end_half = AUDIO_NO_END; /* the half with the last samples of the stream */
+static uint8_t audio_active = 0U;
+
+static uint8_t audio_buffer[EVE_AUDIO_CHUNK];
+
+/* fill one half of the ring from the source, with silence after the end of the stream */
+static uint32_t audio_fill(uint8_t half)
+{
+    uint32_t offset = 0UL;
+
+    while (offset < audio_half)
+    {
+        uint32_t len = audio_half - offset;
+        uint32_t got = 0UL;
+
+        if (len > EVE_AUDIO_CHUNK)
+        {
+            len = EVE_AUDIO_CHUNK;
+        }
+
+        if (AUDIO_NO_END == audio_end_half)
+        {
+            got = audio_source(audio_buffer, len);
+            if (got < len)
+            {
+                audio_end_half = half;
+            }
+        }
+
+        for (uint32_t index = got; index < len; index++)
+        {
+            audio_buffer[index] = audio_silence;
+        }
+
+        EVE_memWrite_sram_buffer(audio_address + (half * audio_half) + offset, audio_buffer, len);
+        offset += len;
+    }
+    return (offset);
+}
+
+/**
+ * @brief Start to play a stream from the source thru a ring buffer of "size" bytes in RAM_G.
+ * @param format EVE_LINEAR_SAMPLES, EVE_ULAW_SAMPLES or EVE_ADPCM_SAMPLES
+ * @param volume written to REG_VOL_PB, EVE_init() sets it to 0
+ * @note The ring is filled completely before the playback starts, address needs to be 8 byte aligned.
+ * @return E_OK, E_NOT_OK if the size is less than 16 bytes or the address is not 8 byte aligned
+ */
+uint8_t EVE_audio_play(uint32_t address, uint32_t size, uint32_t format, uint16_t frequency, uint8_t volume,
+                       EVE_media_source p_source)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if ((size >= 16UL) && (0UL == (address & 7UL)) && (p_source != NULL))
+    {
+        audio_source = p_source;
+        audio_address = address;
+        audio_half = (size / 2UL) & ~7UL; /* a multiple of 8 for the start and length registers */
+        audio_silence = (EVE_ULAW_SAMPLES == format) ? 0xFFU : 0U;
+        audio_playing_half = 0U;
+        audio_end_half = AUDIO_NO_END;
+
+        (void) audio_fill(0U);
+        (void) audio_fill(1U);
+
+        EVE_memWrite8(REG_VOL_PB, volume);
+        EVE_memWrite32(REG_PLAYBACK_START, audio_address);
+        EVE_memWrite32(REG_PLAYBACK_LENGTH, audio_half * 2UL);
+        EVE_memWrite16(REG_PLAYBACK_FREQ, frequency);
+        EVE_memWrite8(REG_PLAYBACK_FORMAT, (uint8_t) format);
+        EVE_memWrite8(REG_PLAYBACK_LOOP, 1U);
+        EVE_memWrite8(REG_PLAYBACK_PLAY, 1U);
+        audio_active = 1U;
+        ret = E_OK;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Refill the half of the ring that was played last, does nothing while the other half still plays.
+ * @note Does nothing while a DMA transfer is active.
+ * @return the number of bytes written to RAM_G
+ */
+uint32_t EVE_audio_service(void)
+{
+    uint32_t written = 0UL;
+
+#if defined (EVE_DMA)
+    if (0 == EVE_dma_busy)
+    {
+#endif
+    if (audio_active != 0U)
+    {
+        uint32_t const read_offset = EVE_memRead32(REG_PLAYBACK_READPTR) - audio_address;
+        uint8_t const half = (read_offset >= audio_half) ? 1U : 0U;
+
+        if (half != audio_playing_half)
+        {
+            uint8_t const played = audio_playing_half;
+
+            audio_playing_half = half;
+            if (played == audio_end_half)
+            {
+                EVE_audio_stop(); /* the last samples were played, the other half is silence */
+            }
+            else
+            {
+                written = audio_fill(played);
+            }
+        }
+    }
+#if defined (EVE_DMA)
+    }
+#endif
+
+    return (written);
+}
+
+/**
+ * @brief Check if a stream is playing.
+ */
+uint8_t EVE_audio_is_playing(void)
+{
+    return (audio_active);
+}
+
+/**
+ * @brief Stop the playback right away.
+ */
+void EVE_audio_stop(void)
+{
+    EVE_memWrite32(REG_PLAYBACK_LENGTH, 0UL);
+    EVE_memWrite8(REG_PLAYBACK_LOOP, 0U);
+    EVE_memWrite8(REG_PLAYBACK_PLAY, 1U);
+    audio_active = 0U;
+}
@@ -0,0 +1,65 @@
+/*
+@file    EVE_audio.h
+@brief   streaming audio playback thru a looping ring buffer in RAM_G
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_AUDIO_H
+#define EVE_AUDIO_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+#include "EVE_mediafifo.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* you may define these in your build-environment to use different settings */
+#if !defined (EVE_AUDIO_CHUNK)
+#define EVE_AUDIO_CHUNK 256U /* size of the buffer the source callback fills, a multiple of 8 */
+#endif
+
+uint8_t EVE_audio_play(uint32_t address, uint32_t size, uint32_t format, uint16_t frequency, uint8_t volume,
+                       EVE_media_source p_source);
+uint32_t EVE_audio_service(void);
+uint8_t EVE_audio_is_playing(void);
+void EVE_audio_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_AUDIO_H */
@@ -0,0 +1,281 @@
+/*
+@file    EVE_bitmap_asset.c
+@brief   bitmaps that are drawn either from the flash of BT81x or from RAM_G
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+BT81x can draw ASTC bitmaps directly from the flash, this costs no RAM_G and no copy
+but every frame reads the bitmap thru the flash interface again.
+Bitmaps that are drawn often or large on screen should rather be in RAM_G.
+
+EVE_bitmap_asset_set() counts how often an asset is used, EVE_bitmap_asset_place()
+is called at a convenient time, for example when switching screens, and moves the
+most used bitmaps into RAM_G for as long as the budget allows and the others back
+to the flash.
+Assets that can not be drawn from the flash are always put into RAM_G:
+everything that is not ASTC and ASTC bitmaps that are not aligned to 64 bytes
+in the flash or that are not exactly the size of their blocks.
+
+RAM_G for the assets comes from EVE_ram_g_alloc(), EVE_ram_g_init() must be called first.
+The copy is done with CMD_FLASHREAD and EVE_bitmap_asset_place() waits for it.
+Compressed assets, the ones with a ram_size that differs from their size in the flash,
+are left out of the placement, these need to be loaded by the application which then
+sets ram_address itself.
+
+EVE_ram_g_init(MEM_DYNAMIC, EVE_RAM_G_SIZE - MEM_DYNAMIC);
+EVE_bitmap_asset_init(&assets[0], "logo");
+EVE_bitmap_asset_init(&assets[1], "background");
+...
+EVE_bitmap_asset_set(&assets[1]);
+EVE_cmd_dl_burst(VERTEX2F(0, 0));
+...
+EVE_bitmap_asset_place(assets, 2U, 256UL * 1024UL);
+
+@section History
+
+5.0
+- initial version
+- fix: leave compressed assets to the application instead of copying them raw to RAM_G
+
+*/
+
+#include "EVE_bitmap_asset.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+#if EVE_GEN > 2
+
+#define ASSET_DECIDED 0x01U
+#define ASSET_WANT_RAM 0x02U
+#define ASSET_EXTERN 0x04U /* compressed, loaded by the application */
+
+/* block footprint of the ASTC formats, width in the upper nibble */
+static const uint8_t astc_blocks[14U] =
+{
+    0x44U, 0x54U, 0x55U, 0x65U, 0x66U, 0x85U, 0x86U, 0x88U,
+    0xA5U, 0xA6U, 0xA8U, 0xAAU, 0xCAU, 0xCCU
+};
+
+/**
+ * @brief Calculate the number of bytes of an ASTC bitmap, every block is 16 bytes.
+ * @return the size in bytes, 0 if the format is not ASTC
+ */
+uint32_t EVE_bitmap_asset_astc_size(uint32_t format, uint16_t width, uint16_t height)
+{
+    uint32_t ret = 0UL;
+
+    if ((format >= EVE_ASTC_4X4) && (format <= EVE_ASTC_12X12))
+    {
+        uint8_t const footprint = astc_blocks[format - EVE_ASTC_4X4];
+        uint32_t const block_w = (uint32_t) footprint >> 4U;
+        uint32_t const block_h = (uint32_t) footprint & 0x0FUL;
+
+        ret = ((width + block_w - 1UL) / block_w) * ((height + block_h - 1UL) / block_h) * 16UL;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Check if an asset can be drawn directly from the flash.
+ * @return 1 for uncompressed ASTC bitmaps that are aligned in the flash and consist only of whole blocks
+ */
+uint8_t EVE_bitmap_asset_flash_capable(const EVE_flash_asset *p_flash)
+{
+    uint8_t ret = 0U;
+
+    if ((0UL == (p_flash->offset & (EVE_BITMAP_FLASH_ALIGN - 1UL))) &&
+        (p_flash->size == EVE_bitmap_asset_astc_size(p_flash->format, p_flash->width, p_flash->height)) &&
+        (p_flash->size == p_flash->ram_size) && (p_flash->size != 0UL))
+    {
+        ret = 1U;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Look up an asset with EVE_flash_fs_find(), it starts out in the flash.
+ * @return E_OK on success, E_NOT_OK if the name is not in the index or the asset is not a bitmap
+ * @note An asset that can not be drawn from the flash only gets usable with EVE_bitmap_asset_place().
+ */
+uint8_t EVE_bitmap_asset_init(EVE_bitmap_asset *p_asset, const char *p_name)
+{
+    uint8_t ret = E_NOT_OK;
+
+    p_asset->ram_address = EVE_RAM_G_NONE;
+    p_asset->uses = 0U;
+    p_asset->flags = 0U;
+
+    if (E_OK == EVE_flash_fs_find(p_name, &p_asset->flash))
+    {
+        if (p_asset->flash.format != EVE_FLASH_FS_RAW)
+        {
+            ret = E_OK;
+        }
+    }
+    return (ret);
+}
+
+static uint8_t asset_to_ram(EVE_bitmap_asset *p_asset)
+{
+    uint8_t ret = E_OK;
+
+    if (EVE_RAM_G_NONE == p_asset->ram_address)
+    {
+        uint32_t const address = EVE_ram_g_alloc(p_asset->flash.size);
+
+        if (EVE_RAM_G_NONE == address)
+        {
+            ret = E_NOT_OK;
+        }
+        else
+        {
+            EVE_cmd_flashread(address, p_asset->flash.offset, p_asset->flash.size);
+            p_asset->ram_address = address;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Decide for each asset if it is drawn from the flash or from RAM_G and move it there.
+ * @param budget the number of bytes of RAM_G the assets that could be drawn from the flash may use
+ * @return E_OK on success, E_NOT_OK if EVE_ram_g_alloc() failed for one of the assets
+ * @note Assets that can not be drawn from the flash are always put into RAM_G and are not
+ * @note counted against the budget, assets are ranked by their use count which is halved after.
+ * @note Compressed assets are not touched, neither moved nor freed.
+ * @note This waits for the coprocessor, do not call it while a display list is being built.
+ */
+uint8_t EVE_bitmap_asset_place(EVE_bitmap_asset *p_assets, uint16_t count, uint32_t budget)
+{
+    uint32_t remaining = budget;
+    uint8_t ret = E_OK;
+
+    for (uint16_t idx = 0U; idx < count; idx++)
+    {
+        p_assets[idx].flags = 0U;
+
+        if (p_assets[idx].flash.ram_size != p_assets[idx].flash.size)
+        {
+            p_assets[idx].flags = ASSET_DECIDED | ASSET_EXTERN;
+        }
+        else if (0U == EVE_bitmap_asset_flash_capable(&p_assets[idx].flash))
+        {
+            p_assets[idx].flags = ASSET_DECIDED | ASSET_WANT_RAM;
+        }
+    }
+
+    /* rank the remaining assets by use, the ones that do not fit go to the flash */
+    for (;;)
+    {
+        uint16_t best = count;
+
+        for (uint16_t idx = 0U; idx < count; idx++)
+        {
+            if (0U == (p_assets[idx].flags & ASSET_DECIDED))
+            {
+                if ((best == count) || (p_assets[idx].uses > p_assets[best].uses))
+                {
+                    best = idx;
+                }
+            }
+        }
+
+        if (best == count)
+        {
+            break;
+        }
+
+        p_assets[best].flags = ASSET_DECIDED;
+
+        if ((p_assets[best].uses != 0U) && (p_assets[best].flash.size <= remaining))
+        {
+            p_assets[best].flags |= ASSET_WANT_RAM;
+            remaining -= p_assets[best].flash.size;
+        }
+    }
+
+    /* free first so the new allocations can use the space */
+    for (uint16_t idx = 0U; idx < count; idx++)
+    {
+        if ((0U == (p_assets[idx].flags & (ASSET_WANT_RAM | ASSET_EXTERN))) &&
+            (p_assets[idx].ram_address != EVE_RAM_G_NONE))
+        {
+            EVE_ram_g_free(p_assets[idx].ram_address);
+            p_assets[idx].ram_address = EVE_RAM_G_NONE;
+        }
+    }
+
+    for (uint16_t idx = 0U; idx < count; idx++)
+    {
+        if ((p_assets[idx].flags & ASSET_WANT_RAM) != 0U)
+        {
+            if (asset_to_ram(&p_assets[idx]) != E_OK)
+            {
+                ret = E_NOT_OK;
+            }
+        }
+        p_assets[idx].uses = p_assets[idx].uses >> 1U;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Get the address for BITMAP_SOURCE or EVE_cmd_setbitmap().
+ * @note The flash is addressed in units of 32 bytes with bit 23 set.
+ */
+uint32_t EVE_bitmap_asset_source(const EVE_bitmap_asset *p_asset)
+{
+    uint32_t ret = p_asset->ram_address;
+
+    if (EVE_RAM_G_NONE == ret)
+    {
+        ret = 0x800000UL | (p_asset->flash.offset >> 5U);
+    }
+    return (ret);
+}
+
+/**
+ * @brief Set up the current bitmap handle for the asset with CMD_SETBITMAP and count the use.
+ * @note Works with and without burst-mode, just like EVE_cmd_setbitmap().
+ */
+void EVE_bitmap_asset_set(EVE_bitmap_asset *p_asset)
+{
+    EVE_cmd_setbitmap(EVE_bitmap_asset_source(p_asset), (uint16_t) p_asset->flash.format,
+                      p_asset->flash.width, p_asset->flash.height);
+
+    if (p_asset->uses < 0xFFFFU)
+    {
+        p_asset->uses++;
+    }
+}
+
+#endif /* EVE_GEN > 2 */
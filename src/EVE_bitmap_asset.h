@@ -0,0 +1,76 @@
+/*
+@file    EVE_bitmap_asset.h
+@brief   prototypes and definitions for bitmaps that are drawn either from the flash of BT81x or from RAM_G
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_BITMAP_ASSET_H
+#define EVE_BITMAP_ASSET_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+#include "EVE_flash_fs.h"
+#include "EVE_ram_g.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if EVE_GEN > 2
+
+#define EVE_BITMAP_FLASH_ALIGN 64UL /* ASTC bitmaps in the flash need to start on this */
+
+typedef struct
+{
+    EVE_flash_asset flash;
+    uint32_t ram_address; /* EVE_RAM_G_NONE while the bitmap is drawn from the flash */
+    uint16_t uses;        /* counted by EVE_bitmap_asset_set(), halved by EVE_bitmap_asset_place() */
+    uint8_t flags;        /* private to EVE_bitmap_asset.c */
+} EVE_bitmap_asset;
+
+uint32_t EVE_bitmap_asset_astc_size(uint32_t format, uint16_t width, uint16_t height);
+uint8_t EVE_bitmap_asset_flash_capable(const EVE_flash_asset *p_flash);
+uint8_t EVE_bitmap_asset_init(EVE_bitmap_asset *p_asset, const char *p_name);
+uint8_t EVE_bitmap_asset_place(EVE_bitmap_asset *p_assets, uint16_t count, uint32_t budget);
+uint32_t EVE_bitmap_asset_source(const EVE_bitmap_asset *p_asset);
+void EVE_bitmap_asset_set(EVE_bitmap_asset *p_asset);
+
+#endif /* EVE_GEN > 2 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_BITMAP_ASSET_H */
@@ -0,0 +1,176 @@
+/*
+@file    EVE_cache.c
+@brief   widgets that are rendered once with CMD_SNAPSHOT2 and then drawn as bitmap until their inputs change
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+Widgets like CMD_GAUGE, CMD_CLOCK and CMD_GRADIENT expand to a lot of display list words
+and keep the coprocessor and the renderer busy even when they show the same value for minutes.
+A cached widget is drawn live once and CMD_SNAPSHOT2 copies its area of the screen to RAM_G,
+after that it is a single bitmap until the key changes, the key stands for everything the
+widget shows, like the value of a gauge or the minute of a clock.
+
+The snapshot is taken from the display list that is shown, so the area of the widget is captured
+as it is on the screen, including the background, and there is no extra frame to be seen.
+The widget should have an opaque background and nothing else should be drawn over it.
+
+EVE_widget_cache gauge;
+EVE_cache_init(&gauge, 20, 20, 200U, 200U);
+...
+if (0U == EVE_cache_draw(&gauge, speed))
+{
+    EVE_cmd_gauge(120, 120, 100, 0U, 10U, 5U, speed, 200U);
+}
+...
+EVE_cmd_dl_burst(CMD_SWAP);
+EVE_end_cmd_burst();
+...
+EVE_cache_capture(&gauge); after the display list was swapped in, with the next frame
+
+The bitmaps are RGB565 and are allocated with EVE_ram_g_alloc(), a widget that does not fit
+is drawn live.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#include "EVE_cache.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+#define CACHE_EMPTY 0U
+#define CACHE_CAPTURE 1U /* the widget was drawn live, the snapshot is to be taken */
+#define CACHE_VALID 2U
+
+/**
+ * @brief Set up a cache for a widget in the given area of the screen.
+ */
+void EVE_cache_init(EVE_widget_cache *p_cache, int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt)
+{
+    if (p_cache != NULL)
+    {
+        p_cache->address = EVE_RAM_G_NONE;
+        p_cache->key = 0UL;
+        p_cache->xc0 = xc0;
+        p_cache->yc0 = yc0;
+        p_cache->width = wid;
+        p_cache->height = hgt;
+        p_cache->state = CACHE_EMPTY;
+    }
+}
+
+/**
+ * @brief Draw the cached bitmap if it was rendered with the same key.
+ * @return 1 when the bitmap was drawn, 0 when the widget needs to be drawn live in this frame
+ * @note Works with and without burst-mode, changes the parameters of EVE_CACHE_HANDLE and the vertex format.
+ */
+uint8_t EVE_cache_draw(EVE_widget_cache *p_cache, uint32_t key)
+{
+    uint8_t ret = 0U;
+
+    if (p_cache != NULL)
+    {
+        if ((CACHE_VALID == p_cache->state) && (p_cache->key == key))
+        {
+            EVE_cmd_dl(BITMAP_HANDLE(EVE_CACHE_HANDLE));
+            EVE_cmd_setbitmap(p_cache->address, EVE_RGB565, p_cache->width, p_cache->height);
+            EVE_cmd_dl(DL_VERTEX_FORMAT); /* set to 0 - pixel coordinates for VERTEX2F */
+            EVE_cmd_dl(DL_BEGIN | EVE_BITMAPS);
+            EVE_cmd_dl(VERTEX2F(p_cache->xc0, p_cache->yc0));
+            EVE_cmd_dl(DL_END);
+            ret = 1U;
+        }
+        else
+        {
+            p_cache->key = key;
+            p_cache->state = CACHE_CAPTURE;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Take the snapshot of a widget that was drawn live, does nothing for widgets that are cached already.
+ * @note Meant to be called outside display-list building, after the display list with the live widget was swapped in.
+ * @note Waits for the coprocessor to render the snapshot.
+ */
+void EVE_cache_capture(EVE_widget_cache *p_cache)
+{
+    if ((p_cache != NULL) && (CACHE_CAPTURE == p_cache->state))
+    {
+        if (EVE_RAM_G_NONE == p_cache->address)
+        {
+            p_cache->address = EVE_ram_g_alloc((uint32_t) p_cache->width * p_cache->height * 2UL);
+        }
+
+        if (p_cache->address != EVE_RAM_G_NONE)
+        {
+            EVE_cmd_snapshot2(EVE_RGB565, p_cache->address, p_cache->xc0, p_cache->yc0, p_cache->width,
+                              p_cache->height);
+            p_cache->state = CACHE_VALID;
+        }
+        else
+        {
+            p_cache->state = CACHE_EMPTY; /* no space in RAM_G, stays live */
+        }
+    }
+}
+
+/**
+ * @brief Force the widget to be drawn live and captured again, for changes that are not in the key.
+ */
+void EVE_cache_invalidate(EVE_widget_cache *p_cache)
+{
+    if ((p_cache != NULL) && (CACHE_VALID == p_cache->state))
+    {
+        p_cache->state = CACHE_EMPTY;
+    }
+}
+
+/**
+ * @brief Free the RAM_G of the cache, the widget is drawn live and captured again the next time.
+ */
+void EVE_cache_release(EVE_widget_cache *p_cache)
+{
+    if (p_cache != NULL)
+    {
+        if (p_cache->address != EVE_RAM_G_NONE)
+        {
+            EVE_ram_g_free(p_cache->address);
+        }
+        p_cache->address = EVE_RAM_G_NONE;
+        p_cache->state = CACHE_EMPTY;
+    }
+}
@@ -0,0 +1,76 @@
+/*
+@file    EVE_cache.h
+@brief   widgets that are rendered once with CMD_SNAPSHOT2 and then drawn as bitmap until their inputs change
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_CACHE_H
+#define EVE_CACHE_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+#include "EVE_ram_g.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* you may define these in your build-environment to use different settings */
+#if !defined (EVE_CACHE_HANDLE)
+#define EVE_CACHE_HANDLE 1U /* bitmap handle for drawing the cached widgets */
+#endif
+
+typedef struct
+{
+    uint32_t address; /* RAM_G, EVE_RAM_G_NONE while nothing is allocated */
+    uint32_t key;     /* the inputs of the widget the bitmap was rendered with */
+    int16_t xc0;
+    int16_t yc0;
+    uint16_t width;
+    uint16_t height;
+    uint8_t state;
+} EVE_widget_cache;
+
+void EVE_cache_init(EVE_widget_cache *p_cache, int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt);
+uint8_t EVE_cache_draw(EVE_widget_cache *p_cache, uint32_t key);
+void EVE_cache_capture(EVE_widget_cache *p_cache);
+void EVE_cache_invalidate(EVE_widget_cache *p_cache);
+void EVE_cache_release(EVE_widget_cache *p_cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_CACHE_H */
@@ -0,0 +1,386 @@
+/*
+@file    EVE_calibrate.c
+@brief   touch calibration that is stepped by the application, with a least-squares fit over five or more points
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+EVE_calibrate_manual() waits in a loop for three taps, a single noisy tap skews the matrix.
+Here the application keeps running its own display lists, EVE_calibrate_draw() adds the
+target to it and EVE_calibrate_step() reads REG_TOUCH_DIRECT_XY once per call.
+Each point is the average of EVE_CALIBRATE_SAMPLES readings and the matrix is a least-squares
+fit over all EVE_CALIBRATE_POINTS points, calculated in integer math.
+The calibration fails and starts over when any point is more than EVE_CALIBRATE_MAX_ERROR pixels
+off after the fit.
+
+EVE_calibrate_start(EVE_HSIZE, EVE_VSIZE);
+while (EVE_CALIBRATE_BUSY == EVE_calibrate_step())
+{
+    ...
+    EVE_calibrate_draw();
+    ...
+}
+EVE_calibrate_export(matrix); and store it, at the next boot EVE_calibrate_import(matrix);
+writes the six registers in one transfer.
+
+The raw touch values are 10 bits, as for EVE_calibrate_manual().
+
+EVE_calibrate_transform() does what EVE does to get from REG_TOUCH_RAW_XY to REG_TOUCH_SCREEN_XY,
+for raw samples that were logged at a high rate, like for signatures, and are converted later
+in one go without reading REG_TOUCH_SCREEN_XY for every sample.
+
+@section History
+
+5.0
+- initial version
+- added EVE_calibrate_transform()
+- fix: EVE_calibrate_solve() rejects more than nine points
+
+*/
+
+#include "EVE_calibrate.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+#define CALIBRATE_NO_TOUCH 0x80000000UL
+#define CALIBRATE_RAW_NO_TOUCH 0xFFFFFFFFUL
+#define CALIBRATE_SCREEN_NO_TOUCH 0x80008000UL
+#define CALIBRATE_LIMIT 0x400000000000LL /* 2^46, times 2^16 still fits into int64_t */
+#define CALIBRATE_MAX_POINTS 9U /* more points overflow the int64_t sums in EVE_calibrate_solve() */
+
+/* positions of the targets in 1/16 of the width and height, corners and center first */
+static const uint8_t target_pos[9U][2U] =
+{
+    {2U, 2U}, {14U, 2U}, {14U, 14U}, {2U, 14U}, {8U, 8U}, {8U, 2U}, {14U, 8U}, {8U, 14U}, {2U, 8U}
+};
+
+static EVE_calibrate_point points[EVE_CALIBRATE_POINTS];
+static int32_t sum_x;
+static int32_t sum_y;
+static uint8_t current;
+static uint8_t samples;
+static uint8_t touch_lock;
+static uint8_t status = EVE_CALIBRATE_FAILED;
+
+/**
+ * @brief Start a calibration with targets on an area of width x height starting at 0, 0.
+ * @note Use the visible size of displays that are cut down from larger ones like the EVE2-38.
+ */
+void EVE_calibrate_start(uint16_t width, uint16_t height)
+{
+    for (uint8_t index = 0U; index < EVE_CALIBRATE_POINTS; index++)
+    {
+        points[index].display_x = (int16_t) ((width * target_pos[index][0U]) / 16U);
+        points[index].display_y = (int16_t) ((height * target_pos[index][1U]) / 16U);
+    }
+    sum_x = 0L;
+    sum_y = 0L;
+    current = 0U;
+    samples = 0U;
+    touch_lock = 1U; /* a touch that is already there does not count */
+    status = EVE_CALIBRATE_BUSY;
+}
+
+/**
+ * @brief Read the touch once and move on to the next target after EVE_CALIBRATE_SAMPLES readings.
+ * @return EVE_CALIBRATE_BUSY, EVE_CALIBRATE_DONE when the new matrix is written to EVE,
+ * EVE_CALIBRATE_FAILED when the points do not fit, start over with EVE_calibrate_start() then
+ * @note Call this once per frame or with a few ms in between, the target only changes after the touch was released.
+ */
+uint8_t EVE_calibrate_step(void)
+{
+#if defined (EVE_DMA)
+    if (0 == EVE_dma_busy)
+    {
+#endif
+    if (EVE_CALIBRATE_BUSY == status)
+    {
+        uint32_t const touch_value = EVE_memRead32(REG_TOUCH_DIRECT_XY);
+
+        if ((touch_value & CALIBRATE_NO_TOUCH) != 0UL)
+        {
+            touch_lock = 0U;
+            samples = 0U; /* released too early */
+            sum_x = 0L;
+            sum_y = 0L;
+        }
+        else if (0U == touch_lock)
+        {
+            sum_x += (int32_t) ((touch_value >> 16U) & 0x03FFUL);
+            sum_y += (int32_t) (touch_value & 0x03FFUL);
+            samples++;
+
+            if (EVE_CALIBRATE_SAMPLES == samples)
+            {
+                points[current].touch_x = (int16_t) (sum_x / (int32_t) EVE_CALIBRATE_SAMPLES);
+                points[current].touch_y = (int16_t) (sum_y / (int32_t) EVE_CALIBRATE_SAMPLES);
+                samples = 0U;
+                sum_x = 0L;
+                sum_y = 0L;
+                touch_lock = 1U;
+                current++;
+            }
+        }
+        else
+        {
+            /* wait for the release */
+        }
+
+        if (EVE_CALIBRATE_POINTS == current)
+        {
+            int32_t matrix[EVE_CALIBRATE_MATRIX_SIZE];
+
+            status = EVE_CALIBRATE_FAILED;
+            if (E_OK == EVE_calibrate_solve(points, EVE_CALIBRATE_POINTS, matrix))
+            {
+                uint32_t values[EVE_CALIBRATE_MATRIX_SIZE];
+
+                for (uint8_t index = 0U; index < EVE_CALIBRATE_MATRIX_SIZE; index++)
+                {
+                    values[index] = (uint32_t) matrix[index];
+                }
+                EVE_calibrate_import(values);
+                status = EVE_CALIBRATE_DONE;
+            }
+        }
+    }
+#if defined (EVE_DMA)
+    }
+#endif
+    return (status);
+}
+
+/**
+ * @brief Add the current target to the display list, a dot with the number of the point.
+ * @note Works with and without burst-mode, the graphics context is saved and restored.
+ */
+void EVE_calibrate_draw(void)
+{
+    if (EVE_CALIBRATE_BUSY == status)
+    {
+        int16_t const xc0 = points[current].display_x;
+        int16_t const yc0 = points[current].display_y;
+
+        EVE_cmd_dl(DL_SAVE_CONTEXT);
+        EVE_cmd_dl(DL_COLOR_RGB | 0x0000ffUL);
+        EVE_cmd_dl(DL_VERTEX_FORMAT); /* set to 0 - pixel coordinates for VERTEX2F */
+        EVE_cmd_dl(POINT_SIZE(15U * 16U));
+        EVE_cmd_dl(DL_BEGIN | EVE_POINTS);
+        EVE_cmd_dl(VERTEX2F(xc0, yc0));
+        EVE_cmd_dl(DL_END);
+        EVE_cmd_dl(DL_COLOR_RGB | 0xffffffUL);
+        EVE_cmd_number(xc0, yc0, 27U, EVE_OPT_CENTER, (int32_t) current + 1L);
+        EVE_cmd_dl(DL_RESTORE_CONTEXT);
+    }
+}
+
+/* num * 65536 / den, rounded, with num reduced first to not overflow */
+static uint8_t ratio_q16(int64_t num, int64_t den, int32_t *p_result)
+{
+    int64_t numerator = num;
+    int64_t denominator = den;
+    uint8_t ret = E_NOT_OK;
+
+    while ((numerator > CALIBRATE_LIMIT) || (numerator < -CALIBRATE_LIMIT))
+    {
+        numerator /= 2;
+        denominator /= 2;
+    }
+
+    if (denominator > 0)
+    {
+        int64_t result = numerator * 65536LL;
+
+        result += (result < 0) ? -(denominator / 2) : (denominator / 2);
+        result /= denominator;
+        if ((result <= INT32_MAX) && (result >= INT32_MIN))
+        {
+            *p_result = (int32_t) result;
+            ret = E_OK;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Least-squares fit of the touch matrix, display = (A * touch_x + B * touch_y + C) / 65536 and D, E, F for y.
+ * @param p_points count points with display and 10 bit raw touch coordinates
+ * @param p_matrix the six values for REG_TOUCH_TRANSFORM_A...F
+ * @return E_OK, E_NOT_OK for less than three or more than nine points, when the points are
+ * on a line or a point is more than EVE_CALIBRATE_MAX_ERROR pixels off after the fit
+ * @note The touch values are centered as n * touch - sum(touch) so that the offsets drop out
+ * and two 2x2 systems remain, the products stay within int64_t for up to nine points.
+ */
+uint8_t EVE_calibrate_solve(const EVE_calibrate_point *p_points, uint8_t count, int32_t *p_matrix)
+{
+    int32_t const num = (int32_t) count;
+    int32_t sum_tx = 0L;
+    int32_t sum_ty = 0L;
+    int32_t sum_dx = 0L;
+    int32_t sum_dy = 0L;
+    int64_t suu = 0;
+    int64_t suv = 0;
+    int64_t svv = 0;
+    int64_t sux = 0;
+    int64_t svx = 0;
+    int64_t suy = 0;
+    int64_t svy = 0;
+    uint8_t ret = E_NOT_OK;
+
+    if ((p_points != NULL) && (p_matrix != NULL) && (count >= 3U) && (count <= CALIBRATE_MAX_POINTS))
+    {
+        for (uint8_t index = 0U; index < count; index++)
+        {
+            sum_tx += p_points[index].touch_x;
+            sum_ty += p_points[index].touch_y;
+            sum_dx += p_points[index].display_x;
+            sum_dy += p_points[index].display_y;
+        }
+
+        for (uint8_t index = 0U; index < count; index++)
+        {
+            int64_t const u_val = ((int64_t) num * p_points[index].touch_x) - sum_tx;
+            int64_t const v_val = ((int64_t) num * p_points[index].touch_y) - sum_ty;
+
+            suu += u_val * u_val;
+            suv += u_val * v_val;
+            svv += v_val * v_val;
+            sux += u_val * p_points[index].display_x;
+            svx += v_val * p_points[index].display_x;
+            suy += u_val * p_points[index].display_y;
+            svy += v_val * p_points[index].display_y;
+        }
+
+        int64_t const det = (suu * svv) - (suv * suv);
+
+        if ((E_OK == ratio_q16(((sux * svv) - (svx * suv)) * num, det, &p_matrix[0U])) &&
+            (E_OK == ratio_q16(((svx * suu) - (sux * suv)) * num, det, &p_matrix[1U])) &&
+            (E_OK == ratio_q16(((suy * svv) - (svy * suv)) * num, det, &p_matrix[3U])) &&
+            (E_OK == ratio_q16(((svy * suu) - (suy * suv)) * num, det, &p_matrix[4U])))
+        {
+            p_matrix[2U] = (int32_t) (((((int64_t) sum_dx * 65536LL) - ((int64_t) p_matrix[0U] * sum_tx) -
+                                        ((int64_t) p_matrix[1U] * sum_ty)) + (num / 2)) / num);
+            p_matrix[5U] = (int32_t) (((((int64_t) sum_dy * 65536LL) - ((int64_t) p_matrix[3U] * sum_tx) -
+                                        ((int64_t) p_matrix[4U] * sum_ty)) + (num / 2)) / num);
+            ret = E_OK;
+
+            for (uint8_t index = 0U; index < count; index++)
+            {
+                int64_t const touch_x = p_points[index].touch_x;
+                int64_t const touch_y = p_points[index].touch_y;
+                int64_t const error_x = (((p_matrix[0U] * touch_x) + (p_matrix[1U] * touch_y) + p_matrix[2U]) / 65536LL) -
+                                        p_points[index].display_x;
+                int64_t const error_y = (((p_matrix[3U] * touch_x) + (p_matrix[4U] * touch_y) + p_matrix[5U]) / 65536LL) -
+                                        p_points[index].display_y;
+
+                if ((error_x > EVE_CALIBRATE_MAX_ERROR) || (error_x < -EVE_CALIBRATE_MAX_ERROR) ||
+                    (error_y > EVE_CALIBRATE_MAX_ERROR) || (error_y < -EVE_CALIBRATE_MAX_ERROR))
+                {
+                    ret = E_NOT_OK;
+                }
+            }
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Read REG_TOUCH_TRANSFORM_A...F with a single transfer, to store a calibration.
+ * @note Works for the result of EVE_calibrate_step(), EVE_calibrate_manual() and CMD_CALIBRATE alike.
+ */
+void EVE_calibrate_export(uint32_t *p_matrix)
+{
+    uint8_t buffer[EVE_CALIBRATE_MATRIX_SIZE * 4U];
+
+    EVE_memRead_sram_buffer(REG_TOUCH_TRANSFORM_A, buffer, EVE_CALIBRATE_MATRIX_SIZE * 4U);
+
+    for (uint8_t index = 0U; index < EVE_CALIBRATE_MATRIX_SIZE; index++)
+    {
+        const uint8_t *p_bytes = &buffer[index * 4U];
+
+        p_matrix[index] = ((uint32_t) p_bytes[0U]) | (((uint32_t) p_bytes[1U]) << 8U) |
+                          (((uint32_t) p_bytes[2U]) << 16U) | (((uint32_t) p_bytes[3U]) << 24U);
+    }
+}
+
+/**
+ * @brief Write a stored calibration to REG_TOUCH_TRANSFORM_A...F with a single transfer.
+ */
+void EVE_calibrate_import(const uint32_t *p_matrix)
+{
+    uint8_t buffer[EVE_CALIBRATE_MATRIX_SIZE * 4U];
+
+    for (uint8_t index = 0U; index < EVE_CALIBRATE_MATRIX_SIZE; index++)
+    {
+        buffer[(index * 4U)] = (uint8_t) p_matrix[index];
+        buffer[(index * 4U) + 1U] = (uint8_t) (p_matrix[index] >> 8U);
+        buffer[(index * 4U) + 2U] = (uint8_t) (p_matrix[index] >> 16U);
+        buffer[(index * 4U) + 3U] = (uint8_t) (p_matrix[index] >> 24U);
+    }
+    EVE_memWrite_sram_buffer(REG_TOUCH_TRANSFORM_A, buffer, EVE_CALIBRATE_MATRIX_SIZE * 4U);
+}
+
+/* (sum >> 16) with the rounding towards minus infinity of an arithmetic shift, only the lower 16 bits are used */
+static inline uint32_t transform_shift(int64_t sum)
+{
+    return ((uint32_t) (((uint64_t) (sum + 0x4000000000000000LL)) >> 16U));
+}
+
+/**
+ * @brief Convert raw touch samples to screen coordinates with the touch matrix, bit-exact with EVE.
+ * @param p_matrix REG_TOUCH_TRANSFORM_A...F, as from EVE_calibrate_export()
+ * @param p_raw samples as read from REG_TOUCH_RAW_XY, x in the upper and y in the lower 16 bits
+ * @param p_screen count results in the format of REG_TOUCH_SCREEN_XY, 0x80008000 for samples without a touch,
+ * may be the same buffer as p_raw
+ * @note x = (A * raw_x + B * raw_y + C) >> 16 and y = (D * raw_x + E * raw_y + F) >> 16, the loop has no branches
+ * and no data dependencies between the samples so the compiler can vectorise it.
+ */
+void EVE_calibrate_transform(const uint32_t *p_matrix, const uint32_t *p_raw, uint32_t *p_screen, uint32_t count)
+{
+    int64_t const mat_a = (int32_t) p_matrix[0U];
+    int64_t const mat_b = (int32_t) p_matrix[1U];
+    int64_t const mat_c = (int32_t) p_matrix[2U];
+    int64_t const mat_d = (int32_t) p_matrix[3U];
+    int64_t const mat_e = (int32_t) p_matrix[4U];
+    int64_t const mat_f = (int32_t) p_matrix[5U];
+
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        uint32_t const raw = p_raw[index];
+        int64_t const raw_x = (int64_t) (raw >> 16U);
+        int64_t const raw_y = (int64_t) (raw & 0xFFFFUL);
+        uint32_t const screen_x = transform_shift((mat_a * raw_x) + (mat_b * raw_y) + mat_c);
+        uint32_t const screen_y = transform_shift((mat_d * raw_x) + (mat_e * raw_y) + mat_f);
+        uint32_t const screen = (screen_x << 16U) | (screen_y & 0xFFFFUL);
+
+        p_screen[index] = (CALIBRATE_RAW_NO_TOUCH == raw) ? CALIBRATE_SCREEN_NO_TOUCH : screen;
+    }
+}
@@ -0,0 +1,93 @@
+/*
+@file    EVE_calibrate.h
+@brief   touch calibration that is stepped by the application, with a least-squares fit over five or more points
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+- added EVE_calibrate_transform()
+
+*/
+
+#ifndef EVE_CALIBRATE_H
+#define EVE_CALIBRATE_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* you may define these in your build-environment to use different settings */
+#if !defined (EVE_CALIBRATE_POINTS)
+#define EVE_CALIBRATE_POINTS 5U /* 3...9 */
+#endif
+
+#if !defined (EVE_CALIBRATE_SAMPLES)
+#define EVE_CALIBRATE_SAMPLES 4U /* touch readings that are averaged for each point */
+#endif
+
+#if !defined (EVE_CALIBRATE_MAX_ERROR)
+#define EVE_CALIBRATE_MAX_ERROR 12 /* pixels a point may be off after the fit */
+#endif
+
+#if (EVE_CALIBRATE_POINTS < 3U) || (EVE_CALIBRATE_POINTS > 9U)
+#error "EVE_CALIBRATE_POINTS needs to be 3...9"
+#endif
+
+#define EVE_CALIBRATE_BUSY 0U
+#define EVE_CALIBRATE_DONE 1U
+#define EVE_CALIBRATE_FAILED 2U
+
+#define EVE_CALIBRATE_MATRIX_SIZE 6U /* REG_TOUCH_TRANSFORM_A...F */
+
+typedef struct
+{
+    int16_t display_x;
+    int16_t display_y;
+    int16_t touch_x;
+    int16_t touch_y;
+} EVE_calibrate_point;
+
+void EVE_calibrate_start(uint16_t width, uint16_t height);
+uint8_t EVE_calibrate_step(void);
+void EVE_calibrate_draw(void);
+uint8_t EVE_calibrate_solve(const EVE_calibrate_point *p_points, uint8_t count, int32_t *p_matrix);
+void EVE_calibrate_export(uint32_t *p_matrix);
+void EVE_calibrate_import(const uint32_t *p_matrix);
+void EVE_calibrate_transform(const uint32_t *p_matrix, const uint32_t *p_raw, uint32_t *p_screen, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_CALIBRATE_H */
@@ -158,6 +158,14 @@ without the traling _burst in the name when exceution speed is not an issue - e.
 - Compliance: fixed BARR-C:2018 Rule 6.2c violation in private_string_write()
 - fix: added two EVE_cmd_memzero() calls to EVE_cmd_clearcache() to run CMD_CLEARCACHE on empty display lists
 - cleanup: moved most of the type casts to static inline functions: i16_i16_to_u32(), u16_u16_to_u32() and i32_to_u32()
+- added EVE_cmd_static_list() and EVE_cmd_static_list_burst() to send command lists encoded at compile time
+- added EVE_text_pack() and EVE_cmd_button_packed(), EVE_cmd_keys_packed(), EVE_cmd_text_packed() to send strings
+    that are packed into 32 bit words only once
+- EVE_memRead_sram_buffer() reads the whole block with spi_receive_buffer() on targets that define EVE_SPI_RECEIVE_BUFFER
+- added EVE_coprocessor_reset() to run the fault recovery sequence for a coprocessor that is stuck
+- EVE_text_pack() packs four characters at a time again, with aligned loads thru memcpy()
+- fix: private_packed_write() reads the tables of EVE_TEXT_HANDLE() with fetch_flash_byte() on AVR
+- EVE_memRead8(), EVE_memRead16() and EVE_memRead32() use spi_receive_buffer() as well
 
 */
 
@@ -174,6 +182,8 @@ without the traling _burst in the name when exceution speed is not an issue - e.
 #include <stdio.h>
 #endif
 
+#include <string.h>
+
 static volatile uint8_t cmd_burst = 0U; /* flag to indicate cmd-burst is active */
 static volatile uint8_t fault_recovered = E_OK; /* flag to indicate if EVE_busy triggered a fault recovery */
 
@@ -201,7 +211,11 @@ uint8_t EVE_memRead8(uint32_t const ft_address)
     uint8_t data;
     EVE_cs_set();
     spi_transmit_32(((ft_address >> 16U) & 0x0000007fUL) + (ft_address & 0x0000ff00UL) + ((ft_address & 0x000000ffUL) << 16U));
+#if defined (EVE_SPI_RECEIVE_BUFFER)
+    spi_receive_buffer(&data, 1U);
+#else
     data = spi_receive(DUMMY_BYTE); /* read data byte by sending another dummy byte */
+#endif
     EVE_cs_clear();
     return (data);
 }
@@ -215,9 +229,15 @@ uint16_t EVE_memRead16(uint32_t const ft_address)
 
     EVE_cs_set();
     spi_transmit_32(((ft_address >> 16U) & 0x0000007fUL) + (ft_address & 0x0000ff00UL) + ((ft_address & 0x000000ffUL) << 16U));
+#if defined (EVE_SPI_RECEIVE_BUFFER)
+    uint8_t bytes[2U];
+    spi_receive_buffer(bytes, 2U);
+    data = ((uint16_t) bytes[1U] * 256U) | bytes[0U];
+#else
     uint8_t const lowbyte = spi_receive(DUMMY_BYTE); /* read low byte */
     uint8_t const hibyte = spi_receive(DUMMY_BYTE); /* read high byte */
     data = ((uint16_t) hibyte * 256U) | lowbyte;
+#endif
     EVE_cs_clear();
     return (data);
 }
@@ -230,10 +250,16 @@ uint32_t EVE_memRead32(uint32_t const ft_address)
     uint32_t data;
     EVE_cs_set();
     spi_transmit_32(((ft_address >> 16U) & 0x0000007fUL) + (ft_address & 0x0000ff00UL) + ((ft_address & 0x000000ffUL) << 16U));
+#if defined (EVE_SPI_RECEIVE_BUFFER)
+    uint8_t bytes[4U];
+    spi_receive_buffer(bytes, 4U);
+    data = ((uint32_t) bytes[3U] << 24U) | ((uint32_t) bytes[2U] << 16U) | ((uint32_t) bytes[1U] << 8U) | bytes[0U];
+#else
     data = ((uint32_t) spi_receive(DUMMY_BYTE)); /* read low byte */
     data = ((uint32_t) spi_receive(DUMMY_BYTE) << 8U) | data;
     data = ((uint32_t) spi_receive(DUMMY_BYTE) << 16U) | data;
     data = ((uint32_t) spi_receive(DUMMY_BYTE) << 24U) | data; /* read high byte */
+#endif
     EVE_cs_clear();
     return (data);
 }
@@ -334,10 +360,14 @@ void EVE_memRead_sram_buffer(uint32_t const ft_address, uint8_t *p_data, uint32_
         EVE_cs_set();
         spi_transmit_32(((ft_address >> 16U) & 0x0000007fUL) + (ft_address & 0x0000ff00UL) + ((ft_address & 0x000000ffUL) << 16U));
 
+#if defined (EVE_SPI_RECEIVE_BUFFER)
+        spi_receive_buffer(p_data, len); /* address, dummy byte and data in one transfer */
+#else
         for (uint32_t count = 0U; count < len; count++)
         {
             p_data[count] = spi_receive(0U); /* read data byte by sending another dummy byte */
         }
+#endif
 
         EVE_cs_clear();
     }
@@ -439,6 +469,16 @@ uint8_t EVE_get_and_reset_fault_state(void)
     return (ret);
 }
 
+/**
+ * @brief Reset the coprocessor with the same sequence EVE_busy() uses after a fault.
+ * @note - For a coprocessor that is stuck without a fault, for example waiting in CMD_INFLATE2 for data that never comes.
+ * @note - Everything in the command FIFO is discarded, the external flash is not reinitialized.
+ */
+void EVE_coprocessor_reset(void)
+{
+    CoprocessorFaultRecover();
+}
+
 /**
  * @brief Helper function, wait for the coprocessor to complete the FIFO queue.
  */
@@ -507,6 +547,106 @@ void block_transfer(const uint8_t *p_data, uint32_t len)
     }
 }
 
+/* four characters starting at an aligned address, the first one in the low byte like EVE expects it */
+static inline uint32_t text_load_word(const uint8_t *p_aligned)
+{
+    uint32_t word;
+
+    (void) memcpy(&word, p_aligned, 4U);
+#if defined (__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    word = (word >> 24U) | ((word >> 8U) & 0x0000FF00UL) | ((word << 8U) & 0x00FF0000UL) | (word << 24U);
+#endif
+    return (word);
+}
+
+/* not 0 if one of the four bytes of the word is zero */
+static inline uint32_t text_has_zero(uint32_t word)
+{
+    return ((word - 0x01010101UL) & ~word & 0x80808080UL);
+}
+
+/**
+ * @brief Helper function, pack a string into 32 bit words once to send it with the EVE_cmd_xxx_packed() functions.
+ * @note - "p_buffer" needs to stay valid for as long as the handle is used.
+ * @note - Strings that do not fit into "buffer_words" are truncated and E_NOT_OK is returned.
+ * @note - The string is read in aligned words, up to three bytes next to it in the same word are read as well.
+ */
+uint8_t EVE_text_pack(EVE_text_handle *p_handle, uint32_t *p_buffer, uint16_t buffer_words, const char *p_text)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if ((p_handle != NULL) && (p_buffer != NULL) && (p_text != NULL) && (buffer_words > 0U))
+    {
+        const uint8_t *const p_bytes = (const uint8_t *) p_text;
+        uint32_t const misalign = (uint32_t) (((uintptr_t) p_bytes) & 3U);
+        uint32_t const misalign_bits = misalign * 8U;
+        const uint8_t *p_aligned = (const uint8_t *) (((uintptr_t) p_bytes) - misalign);
+        uint32_t low;
+        uint16_t index = 0U;
+        uint32_t textindex = 0U;
+
+        p_handle->p_words = p_buffer;
+        p_handle->num_words = 0U;
+        p_handle->in_flash = 0U;
+
+        /* four characters at a time for as long as there is no zero, the loads are aligned */
+        /* and so never cross a page, the bytes in front of the string are masked as not zero */
+        low = text_load_word(p_aligned) | ((1UL << misalign_bits) - 1UL);
+        p_aligned = &p_aligned[4U];
+
+        while ((index < buffer_words) && (0U == text_has_zero(low)))
+        {
+            uint32_t word = low;
+            uint32_t const high = text_load_word(p_aligned); /* "low" has no zero, so the string goes on */
+
+            if (misalign_bits != 0U)
+            {
+                word = (low >> misalign_bits) | (high << (32U - misalign_bits));
+                if (text_has_zero(word) != 0U)
+                {
+                    break;
+                }
+            }
+
+            p_buffer[index] = word;
+            index++;
+            textindex += 4U;
+            low = high;
+            p_aligned = &p_aligned[4U];
+        }
+
+        /* the rest is built from the bytes, up to and including the terminating zero */
+        while ((index < buffer_words) && (E_NOT_OK == ret))
+        {
+            uint32_t word = 0U;
+
+            for (uint8_t shift = 0U; shift < 32U; shift += 8U)
+            {
+                uint8_t data = p_bytes[textindex];
+
+                if (0U == data)
+                {
+                    ret = E_OK;
+                    break;
+                }
+                word |= ((uint32_t) data) << shift;
+                textindex++;
+            }
+            p_buffer[index] = word;
+            index++;
+        }
+
+        if (ret != E_OK) /* out of space, terminate the truncated string */
+        {
+            p_buffer[index - 1U] &= 0x00FFFFFFUL;
+        }
+
+        p_handle->num_words = index;
+    }
+
+    return (ret);
+}
+
 /* ##################################################################
     coprocessor commands that are not used in displays lists,
     these are not to be used with burst transfers
@@ -1786,6 +1926,62 @@ static void private_string_write(const char *p_text)
     }
 }
 
+/* get a word of a packed string, the tables of EVE_TEXT_HANDLE() are in FLASH for controllers like AVR */
+static uint32_t private_packed_word(const EVE_text_handle *p_handle, uint16_t index)
+{
+    uint32_t ret;
+
+#if defined (__AVR__)
+    if (p_handle->in_flash != 0U)
+    {
+        const uint8_t *const p_bytes = (const uint8_t *) &p_handle->p_words[index];
+
+        ret = fetch_flash_byte(&p_bytes[0U]);
+        ret |= ((uint32_t) fetch_flash_byte(&p_bytes[1U])) << 8U;
+        ret |= ((uint32_t) fetch_flash_byte(&p_bytes[2U])) << 16U;
+        ret |= ((uint32_t) fetch_flash_byte(&p_bytes[3U])) << 24U;
+    }
+    else
+    {
+        ret = p_handle->p_words[index];
+    }
+#else
+    ret = p_handle->p_words[index];
+#endif
+    return (ret);
+}
+
+/* write a string that was packed with EVE_text_pack() in context of a command */
+static void private_packed_write(const EVE_text_handle *p_handle)
+{
+    if ((NULL == p_handle) || (NULL == p_handle->p_words) || (0U == p_handle->num_words))
+    {
+        /* an empty string still needs to be terminated */
+        if (0U == cmd_burst)
+        {
+            spi_transmit_32(0U);
+        }
+        else
+        {
+            spi_transmit_burst(0U);
+        }
+    }
+    else if (0U == cmd_burst)
+    {
+        for (uint16_t index = 0U; index < p_handle->num_words; index++)
+        {
+            spi_transmit_32(private_packed_word(p_handle, index));
+        }
+    }
+    else
+    {
+        for (uint16_t index = 0U; index < p_handle->num_words; index++)
+        {
+            spi_transmit_burst(private_packed_word(p_handle, index));
+        }
+    }
+}
+
 /* BT817 / BT818 */
 #if EVE_GEN > 3
 
@@ -2689,6 +2885,40 @@ void EVE_cmd_button_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
     private_string_write(p_text);
 }
 
+/**
+ * @brief Draw a button with a label that was packed with EVE_text_pack().
+ */
+void EVE_cmd_button_packed(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
+                           uint16_t font, uint16_t options, const EVE_text_handle *p_handle)
+{
+    if (0U == cmd_burst)
+    {
+        eve_begin_cmd(CMD_BUTTON);
+        spi_transmit_32(i16_i16_to_u32(xc0, yc0));
+        spi_transmit_32(u16_u16_to_u32(wid, hgt));
+        spi_transmit_32(u16_u16_to_u32(font, options));
+        private_packed_write(p_handle);
+        EVE_cs_clear();
+    }
+    else
+    {
+        EVE_cmd_button_packed_burst(xc0, yc0, wid, hgt, font, options, p_handle);
+    }
+}
+
+/**
+ * @brief Draw a button with a label that was packed with EVE_text_pack(), only works in burst-mode.
+ */
+void EVE_cmd_button_packed_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
+                                 uint16_t font, uint16_t options, const EVE_text_handle *p_handle)
+{
+    spi_transmit_burst(CMD_BUTTON);
+    spi_transmit_burst(i16_i16_to_u32(xc0, yc0));
+    spi_transmit_burst(u16_u16_to_u32(wid, hgt));
+    spi_transmit_burst(u16_u16_to_u32(font, options));
+    private_packed_write(p_handle);
+}
+
 /**
  * @brief Execute the touch screen calibration routine.
  * @note - does not support burst-mode
@@ -3001,6 +3231,40 @@ void EVE_cmd_keys_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
     private_string_write(p_text);
 }
 
+/**
+ * @brief Draw a row of keys that was packed with EVE_text_pack().
+ */
+void EVE_cmd_keys_packed(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
+                         uint16_t font, uint16_t options, const EVE_text_handle *p_handle)
+{
+    if (0U == cmd_burst)
+    {
+        eve_begin_cmd(CMD_KEYS);
+        spi_transmit_32(i16_i16_to_u32(xc0, yc0));
+        spi_transmit_32(u16_u16_to_u32(wid, hgt));
+        spi_transmit_32(u16_u16_to_u32(font, options));
+        private_packed_write(p_handle);
+        EVE_cs_clear();
+    }
+    else
+    {
+        EVE_cmd_keys_packed_burst(xc0, yc0, wid, hgt, font, options, p_handle);
+    }
+}
+
+/**
+ * @brief Draw a row of keys that was packed with EVE_text_pack(), only works in burst-mode.
+ */
+void EVE_cmd_keys_packed_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
+                               uint16_t font, uint16_t options, const EVE_text_handle *p_handle)
+{
+    spi_transmit_burst(CMD_KEYS);
+    spi_transmit_burst(i16_i16_to_u32(xc0, yc0));
+    spi_transmit_burst(u16_u16_to_u32(wid, hgt));
+    spi_transmit_burst(u16_u16_to_u32(font, options));
+    private_packed_write(p_handle);
+}
+
 /**
  * @brief Draw a number.
  */
@@ -3461,6 +3725,57 @@ void EVE_cmd_spinner_burst(int16_t xc0, int16_t yc0, uint16_t style, uint16_t sc
     spi_transmit_burst(u16_u16_to_u32(style, scale));
 }
 
+/**
+ * @brief Send a pre-encoded list of display-list and coprocessor commands, for example built with EVE_static_dl.h.
+ * @note - "num" is the number of 32 bit words in the list.
+ * @note - The list is located in FLASH for controllers like AVR that need to use fetch_flash_byte().
+ * @note - In burst-mode with DMA the list needs to fit in the remaining space of EVE_dma_buffer[].
+ */
+void EVE_cmd_static_list(const uint32_t *p_list, uint16_t num)
+{
+    if (p_list != NULL)
+    {
+        if (0U == cmd_burst)
+        {
+            block_transfer((const uint8_t *) p_list, ((uint32_t) num) * 4UL);
+        }
+        else
+        {
+            EVE_cmd_static_list_burst(p_list, num);
+        }
+    }
+}
+
+/**
+ * @brief Send a pre-encoded list of display-list and coprocessor commands, only works in burst-mode.
+ */
+void EVE_cmd_static_list_burst(const uint32_t *p_list, uint16_t num)
+{
+    if (p_list != NULL)
+    {
+#if defined (__AVR__)
+        const uint8_t *const p_bytes = (const uint8_t *) p_list;
+
+        for (uint16_t index = 0U; index < num; index++)
+        {
+            uint32_t calc;
+            uint16_t offset = index * 4U;
+
+            calc = fetch_flash_byte(&p_bytes[offset]);
+            calc |= ((uint32_t) fetch_flash_byte(&p_bytes[offset + 1U])) << 8U;
+            calc |= ((uint32_t) fetch_flash_byte(&p_bytes[offset + 2U])) << 16U;
+            calc |= ((uint32_t) fetch_flash_byte(&p_bytes[offset + 3U])) << 24U;
+            spi_transmit_burst(calc);
+        }
+#else
+        for (uint16_t index = 0U; index < num; index++)
+        {
+            spi_transmit_burst(p_list[index]);
+        }
+#endif
+    }
+}
+
 /**
  * @brief Draw a text string.
  */
@@ -3494,6 +3809,37 @@ void EVE_cmd_text_burst(int16_t xc0, int16_t yc0, uint16_t font, uint16_t option
     private_string_write(p_text);
 }
 
+/**
+ * @brief Draw a text string that was packed with EVE_text_pack().
+ */
+void EVE_cmd_text_packed(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options, const EVE_text_handle *p_handle)
+{
+    if (0U == cmd_burst)
+    {
+        eve_begin_cmd(CMD_TEXT);
+        spi_transmit_32(i16_i16_to_u32(xc0, yc0));
+        spi_transmit_32(u16_u16_to_u32(font, options));
+        private_packed_write(p_handle);
+        EVE_cs_clear();
+    }
+    else
+    {
+        EVE_cmd_text_packed_burst(xc0, yc0, font, options, p_handle);
+    }
+}
+
+/**
+ * @brief Draw a text string that was packed with EVE_text_pack(), only works in burst-mode.
+ */
+void EVE_cmd_text_packed_burst(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options,
+                               const EVE_text_handle *p_handle)
+{
+    spi_transmit_burst(CMD_TEXT);
+    spi_transmit_burst(i16_i16_to_u32(xc0, yc0));
+    spi_transmit_burst(u16_u16_to_u32(font, options));
+    private_packed_write(p_handle);
+}
+
 /**
  * @brief Draw a toggle switch with labels.
  */
@@ -85,6 +85,12 @@ EVE_cmd_animstartram_burst()
 - commented out EVE_cmd_regread() prototype
 - removed prototype for EVE_cmd_hsf_burst()
 - added static inline functions: i16_i16_to_u32(), u16_u16_to_u32() and i32_to_u32()
+- added prototypes for EVE_cmd_static_list() and EVE_cmd_static_list_burst()
+- added type EVE_text_handle and prototypes for EVE_text_pack(), EVE_cmd_button_packed(), EVE_cmd_keys_packed()
+    and EVE_cmd_text_packed()
+- added EVE_FAIL_FLASH_VERIFY
+- added prototype for EVE_coprocessor_reset()
+- added in_flash to EVE_text_handle for the const tables of EVE_TEXT_HANDLE() that are in FLASH on AVR
 
 */
 
@@ -114,12 +120,21 @@ EVE_cmd_animstartram_burst()
 #define EVE_IS_BUSY 12U
 #define EVE_FIFO_HALF_EMPTY 13U
 #define EVE_FAULT_RECOVERED 14U
+#define EVE_FAIL_FLASH_VERIFY 15U
 
 #define EVE_FLASH_STATUS_INIT 0U
 #define EVE_FLASH_STATUS_DETACHED 1U
 #define EVE_FLASH_STATUS_BASIC 2U
 #define EVE_FLASH_STATUS_FULL 3U
 
+/* a string that is packed into 32 bit words with EVE_text_pack() or at compile time with EVE_DL_CHARS() */
+typedef struct
+{
+    const uint32_t *p_words; /* the last word holds at least one zero byte */
+    uint16_t num_words;
+    uint8_t in_flash; /* 1 if p_words is a const table that needs to be read with fetch_flash_byte() on AVR */
+} EVE_text_handle;
+
 /* ##################################################################
     functions that convert to uint32
 ##################################################################### */
@@ -156,7 +171,9 @@ void EVE_memWrite_sram_buffer(uint32_t const ft_address, const uint8_t *p_data,
 void EVE_memRead_sram_buffer(uint32_t const ft_address, uint8_t *p_data, uint32_t const len);
 uint8_t EVE_busy(void);
 uint8_t EVE_get_and_reset_fault_state(void);
+void EVE_coprocessor_reset(void);
 void EVE_execute_cmd(void);
+uint8_t EVE_text_pack(EVE_text_handle *p_handle, uint32_t *p_buffer, uint16_t buffer_words, const char *p_text);
 
 /* ##################################################################
     commands and functions to be used outside of display-lists
@@ -294,6 +311,8 @@ void EVE_cmd_bgcolor(uint32_t color);
 void EVE_cmd_bgcolor_burst(uint32_t color);
 void EVE_cmd_button(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t font, uint16_t options, const char *p_text);
 void EVE_cmd_button_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t font, uint16_t options, const char *p_text);
+void EVE_cmd_button_packed(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t font, uint16_t options, const EVE_text_handle *p_handle);
+void EVE_cmd_button_packed_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t font, uint16_t options, const EVE_text_handle *p_handle);
 void EVE_cmd_calibrate(void);
 void EVE_cmd_clock(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options, uint16_t hours, uint16_t mins, uint16_t secs, uint16_t msecs);
 void EVE_cmd_clock_burst(int16_t xc0, int16_t yc0, uint16_t rad, uint16_t options, uint16_t hours, uint16_t mins, uint16_t secs, uint16_t msecs);
@@ -310,6 +329,8 @@ void EVE_cmd_gradient(int16_t xc0, int16_t yc0, uint32_t rgb0, int16_t xc1, int1
 void EVE_cmd_gradient_burst(int16_t xc0, int16_t yc0, uint32_t rgb0, int16_t xc1, int16_t yc1, uint32_t rgb1);
 void EVE_cmd_keys(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t font, uint16_t options, const char *p_text);
 void EVE_cmd_keys_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t font, uint16_t options, const char *p_text);
+void EVE_cmd_keys_packed(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t font, uint16_t options, const EVE_text_handle *p_handle);
+void EVE_cmd_keys_packed_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t font, uint16_t options, const EVE_text_handle *p_handle);
 void EVE_cmd_number(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options, int32_t number);
 void EVE_cmd_number_burst(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options, int32_t number);
 void EVE_cmd_progress(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t options, uint16_t val, uint16_t range);
@@ -338,8 +359,12 @@ void EVE_cmd_slider(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16
 void EVE_cmd_slider_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt, uint16_t options, uint16_t val, uint16_t range);
 void EVE_cmd_spinner(int16_t xc0, int16_t yc0, uint16_t style, uint16_t scale);
 void EVE_cmd_spinner_burst(int16_t xc0, int16_t yc0, uint16_t style, uint16_t scale);
+void EVE_cmd_static_list(const uint32_t *p_list, uint16_t num);
+void EVE_cmd_static_list_burst(const uint32_t *p_list, uint16_t num);
 void EVE_cmd_text(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options, const char *p_text);
 void EVE_cmd_text_burst(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options, const char *p_text);
+void EVE_cmd_text_packed(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options, const EVE_text_handle *p_handle);
+void EVE_cmd_text_packed_burst(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options, const EVE_text_handle *p_handle);
 void EVE_cmd_toggle(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t font, uint16_t options, uint16_t state, const char *p_text);
 void EVE_cmd_toggle_burst(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t font, uint16_t options, uint16_t state, const char *p_text);
 void EVE_cmd_translate(int32_t tr_x, int32_t tr_y);
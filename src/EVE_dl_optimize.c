@@ -0,0 +1,491 @@
+/*
+@file    EVE_dl_optimize.c
+@brief   peephole optimiser for lists of display list and coprocessor commands
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+EVE_dl_optimize() works on a list in RAM in the format of EVE_cmd_static_list(),
+display list commands and coprocessor commands with their arguments, for example a frame
+that was put together in a buffer before it is sent.
+The list is changed in place and the new number of words is returned:
+- BEGIN of the primitive that is already active is dropped together with the END before it,
+  for LINES and RECTS only after complete pairs, never for strips as these would connect
+- END directly followed by BEGIN is dropped as BEGIN ends the previous primitive anyways
+- BEGIN / END pairs without a vertex are dropped
+- VERTEX2F is replaced by VERTEX2II when it is on full pixels in 0...511
+  and for BITMAPS when the bitmap handle and cell are known
+- state that is set to the value it already has is dropped, this includes VERTEX_FORMAT,
+  VERTEX_TRANSLATE_X/Y, the colors, BITMAP_HANDLE and CELL, but not the per handle
+  bitmap state like BITMAP_SOURCE
+- NOP is dropped
+
+The state is only known after CMD_DLSTART and after the commands setting it in the list,
+every other coprocessor command, MACRO and RESTORE_CONTEXT make it unknown again.
+Lists with CALL, JUMP or RETURN are not changed as removing words would move the targets.
+When a coprocessor command is followed by data of unknown length, like CMD_INFLATE,
+the rest of the list is not changed.
+
+static uint32_t frame[512U];
+uint16_t num;
+...
+num = EVE_dl_optimize(frame, num);
+EVE_cmd_static_list(frame, num);
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#include "EVE_dl_optimize.h"
+
+#if !defined (NULL)
+#include <stdio.h>
+#endif
+
+#define DL_OPT_ARGS_STRING 0x80U  /* a zero-terminated string follows the arguments */
+#define DL_OPT_ARGS_DATA 0x40U    /* the last argument is the number of bytes following */
+#define DL_OPT_ARGS_OPTIONS 0x20U /* data of unknown length follows unless the last argument has EVE_OPT_MEDIAFIFO */
+#define DL_OPT_ARGS_STOP 0xFFU    /* data of unknown length follows */
+#define DL_OPT_ARGS_COUNT 0x1FU
+
+#if EVE_GEN > 2
+#define DL_OPT_NO_DATA ((uint32_t) (EVE_OPT_MEDIAFIFO | EVE_OPT_FLASH))
+#else
+#define DL_OPT_NO_DATA ((uint32_t) EVE_OPT_MEDIAFIFO)
+#endif
+
+#define DL_OPT_PRIM_NONE 0U
+#define DL_OPT_PRIM_UNKNOWN 0xFFU
+
+#define DL_OPT_OPCODES 0x30U
+
+/* number of argument words of the coprocessor commands 0xffffff00 to 0xffffff70 */
+static const uint8_t command_args[0x71U] =
+{
+    0U, 0U, 1U, DL_OPT_ARGS_STOP, DL_OPT_ARGS_STOP, DL_OPT_ARGS_STOP, DL_OPT_ARGS_STOP, DL_OPT_ARGS_STOP, /* 0x00 */
+    DL_OPT_ARGS_STOP, 1U, 1U, 4U, DL_OPT_ARGS_STRING | 2U, DL_OPT_ARGS_STRING | 3U, DL_OPT_ARGS_STRING | 3U, 4U, /* 0x08 */
+    4U, 4U, DL_OPT_ARGS_STRING | 3U, 4U, 4U, 1U, 2U, 0U, /* 0x10 */
+    3U, 2U, DL_OPT_ARGS_DATA | 2U, 3U, 2U, 3U, 2U, 1U, /* 0x18 */
+    DL_OPT_ARGS_STOP, 13U, DL_OPT_ARGS_STOP, 1U, DL_OPT_ARGS_OPTIONS | 2U, 3U, 0U, 2U, /* 0x20 */
+    2U, 1U, 0U, 2U, 3U, 3U, 3U, 0U, /* 0x28 */
+    4U, 0U, 0U, 6U, 1U, DL_OPT_ARGS_STOP, 1U, 4U, /* 0x30 */
+    1U, 2U, DL_OPT_ARGS_OPTIONS | 1U, 3U, 1U, DL_OPT_ARGS_STOP, DL_OPT_ARGS_STOP, 2U, /* 0x38 */
+    0U, 2U, 0U, 3U, 0U, DL_OPT_ARGS_DATA | 2U, 3U, 3U, /* 0x40 */
+    0U, 0U, 1U, 0U, DL_OPT_ARGS_DATA | 1U, 2U, 1U, 0U, /* 0x48 */
+    DL_OPT_ARGS_OPTIONS | 2U, 4U, 0U, 3U, 1U, 2U, 1U, 4U, /* 0x50 */
+    1U, 2U, 3U, DL_OPT_ARGS_STOP, DL_OPT_ARGS_STOP, DL_OPT_ARGS_STOP, 1U, 0U, /* 0x58 */
+    3U, 0U, 1U, 1U, 5U, 1U, 0U, 1U, /* 0x60 */
+    1U, 0U, 3U, 3U, 2U, 3U, 3U, 2U, /* 0x68 */
+    3U /* 0x70 */
+};
+
+typedef struct
+{
+    uint16_t vertices; /* since the BEGIN that is active in the output */
+    uint8_t prim;
+    uint8_t pending_end;
+} dl_opt_prim;
+
+static struct
+{
+    uint32_t *p_list;
+    uint16_t out;
+    dl_opt_prim current;
+    dl_opt_prim saved;       /* before the last BEGIN, restored when it gets no vertex */
+    uint16_t begin_index;
+    uint16_t new_vertices;   /* since the last BEGIN */
+    uint8_t in_begin;
+    uint8_t begin_emitted;
+    uint64_t state_known;
+    uint32_t state[DL_OPT_OPCODES];
+} opt;
+
+/* number of words of the coprocessor command at index including arguments and data, 0 if not known */
+static uint16_t command_length(const uint32_t *p_list, uint16_t index, uint16_t num)
+{
+    uint32_t const cmd = p_list[index];
+    uint32_t len = 0U;
+
+    if (((cmd & 0xFFFFFF00UL) == 0xFFFFFF00UL) && ((cmd & 0xFFUL) < sizeof(command_args)))
+    {
+        uint8_t const args = command_args[cmd & 0xFFUL];
+
+        if (args != DL_OPT_ARGS_STOP)
+        {
+            len = 1U + (args & DL_OPT_ARGS_COUNT);
+        }
+
+        if ((0U == len) || ((index + len) > num))
+        {
+            len = 0U;
+        }
+        else if ((args & DL_OPT_ARGS_STRING) != 0U)
+        {
+            uint32_t word;
+
+            do
+            {
+                if ((index + len) >= num)
+                {
+                    len = 0U;
+                    break;
+                }
+                word = p_list[index + len];
+                len++;
+            } while (((word & 0xFFUL) != 0U) && ((word & 0xFF00UL) != 0U) &&
+                     ((word & 0xFF0000UL) != 0U) && ((word & 0xFF000000UL) != 0U));
+        }
+        else if ((args & DL_OPT_ARGS_DATA) != 0U)
+        {
+            len += (p_list[index + len - 1U] + 3UL) / 4UL;
+        }
+        else if (((args & DL_OPT_ARGS_OPTIONS) != 0U) && (0U == (p_list[index + len - 1U] & DL_OPT_NO_DATA)))
+        {
+            len = 0U;
+        }
+        else
+        {
+            /* only arguments */
+        }
+    }
+
+    if ((index + len) > num)
+    {
+        len = 0U;
+    }
+    return ((uint16_t) len);
+}
+
+static void emit(uint32_t word)
+{
+    opt.p_list[opt.out] = word;
+    opt.out++;
+}
+
+static void flush_end(void)
+{
+    if (opt.current.pending_end != 0U)
+    {
+        emit(DL_END);
+        opt.current.pending_end = 0U;
+        opt.current.prim = DL_OPT_PRIM_NONE;
+    }
+}
+
+/* the last BEGIN got no vertex, it is taken out again */
+static void drop_empty_begin(void)
+{
+    if (opt.begin_emitted != 0U)
+    {
+        for (uint16_t index = opt.begin_index; (index + 1U) < opt.out; index++)
+        {
+            opt.p_list[index] = opt.p_list[index + 1U];
+        }
+        opt.out--;
+    }
+    opt.current = opt.saved;
+    opt.in_begin = 0U;
+}
+
+static void reset_state(uint8_t known)
+{
+    opt.state_known = 0U;
+    opt.current.prim = DL_OPT_PRIM_UNKNOWN;
+    opt.current.vertices = 0U;
+    opt.in_begin = 0U;
+
+    if (known != 0U)
+    {
+        /* after CMD_DLSTART */
+        opt.current.prim = DL_OPT_PRIM_NONE;
+        opt.state[DL_VERTEX_FORMAT >> 24U] = DL_VERTEX_FORMAT | 4UL;
+        opt.state[DL_VERTEX_TRANSLATE_X >> 24U] = DL_VERTEX_TRANSLATE_X;
+        opt.state[DL_VERTEX_TRANSLATE_Y >> 24U] = DL_VERTEX_TRANSLATE_Y;
+        opt.state[DL_BITMAP_HANDLE >> 24U] = DL_BITMAP_HANDLE;
+        opt.state[DL_CELL >> 24U] = DL_CELL;
+        opt.state_known = (1ULL << (DL_VERTEX_FORMAT >> 24U)) | (1ULL << (DL_VERTEX_TRANSLATE_X >> 24U)) |
+                          (1ULL << (DL_VERTEX_TRANSLATE_Y >> 24U)) | (1ULL << (DL_BITMAP_HANDLE >> 24U)) |
+                          (1ULL << (DL_CELL >> 24U));
+    }
+}
+
+static uint8_t state_is_known(uint32_t opcode)
+{
+    return ((uint8_t) (((opt.state_known >> opcode) & 1U) != 0U));
+}
+
+/* VERTEX2F as VERTEX2II when it has the same result, the word unchanged otherwise */
+static uint32_t vertex2ii(uint32_t word)
+{
+    uint32_t ret = word;
+    uint32_t const frac_op = DL_VERTEX_FORMAT >> 24U;
+
+    if (((word & 0xC0000000UL) == DL_VERTEX2F) && (opt.current.prim != DL_OPT_PRIM_NONE) &&
+        (opt.current.prim != DL_OPT_PRIM_UNKNOWN) && (state_is_known(frac_op) != 0U) &&
+        (((opt.current.prim != EVE_BITMAPS)) ||
+         ((state_is_known(DL_BITMAP_HANDLE >> 24U) != 0U) && (state_is_known(DL_CELL >> 24U) != 0U))))
+    {
+        uint32_t const frac = opt.state[frac_op] & 7UL;
+        uint32_t const xc0 = (word >> 15U) & 0x7FFFUL;
+        uint32_t const yc0 = word & 0x7FFFUL;
+        uint32_t const mask = (1UL << frac) - 1UL;
+
+        /* positive, on full pixels and not above 511 */
+        if (((xc0 & 0x4000UL) == 0U) && ((yc0 & 0x4000UL) == 0U) && (0U == (xc0 & mask)) &&
+            (0U == (yc0 & mask)) && ((xc0 >> frac) < 512UL) && ((yc0 >> frac) < 512UL))
+        {
+            uint32_t handle = 0U;
+            uint32_t cell = 0U;
+
+            if (EVE_BITMAPS == opt.current.prim)
+            {
+                handle = opt.state[DL_BITMAP_HANDLE >> 24U] & 0x1FUL;
+                cell = opt.state[DL_CELL >> 24U] & 0x7FUL;
+            }
+            ret = DL_VERTEX2II | ((xc0 >> frac) << 21U) | ((yc0 >> frac) << 12U) | (handle << 7U) | cell;
+        }
+    }
+    return (ret);
+}
+
+static void begin(uint32_t word)
+{
+    uint8_t const prim = (uint8_t) (word & 15UL);
+
+    if ((opt.in_begin != 0U) && (0U == opt.new_vertices))
+    {
+        drop_empty_begin();
+    }
+
+    opt.saved = opt.current;
+    opt.begin_emitted = 0U;
+
+    if ((prim == opt.current.prim) &&
+        ((EVE_BITMAPS == prim) || (EVE_POINTS == prim) ||
+         (((EVE_LINES == prim) || (EVE_RECTS == prim)) && (0U == (opt.current.vertices & 1U)))))
+    {
+        /* continues the active primitive, the END before it is not needed either */
+        opt.current.pending_end = 0U;
+    }
+    else
+    {
+        opt.begin_emitted = 1U;
+        opt.begin_index = opt.out;
+        emit(word);
+        opt.current.prim = prim;
+        opt.current.vertices = 0U;
+        opt.current.pending_end = 0U;
+    }
+    opt.in_begin = 1U;
+    opt.new_vertices = 0U;
+}
+
+static void end(void)
+{
+    if ((opt.in_begin != 0U) && (0U == opt.new_vertices))
+    {
+        drop_empty_begin();
+    }
+    opt.in_begin = 0U;
+
+    if (DL_OPT_PRIM_UNKNOWN == opt.current.prim)
+    {
+        emit(DL_END);
+        opt.current.prim = DL_OPT_PRIM_NONE;
+    }
+    else if (opt.current.prim != DL_OPT_PRIM_NONE)
+    {
+        opt.current.pending_end = 1U; /* only sent when no BEGIN follows */
+    }
+    else
+    {
+        /* nothing to end */
+    }
+}
+
+static void state(uint32_t word)
+{
+    uint32_t const opcode = word >> 24U;
+
+    switch (word & 0xFF000000UL)
+    {
+        case DL_NOP:
+            break;
+        case DL_DISPLAY:
+            flush_end();
+            emit(word);
+            break;
+        case DL_SAVE_CONTEXT:
+        case DL_CLEAR:
+            emit(word);
+            break;
+        case DL_RESTORE_CONTEXT:
+        case DL_MACRO:
+            flush_end();
+            emit(word);
+            if (DL_MACRO == (word & 0xFF000000UL))
+            {
+                opt.current.prim = DL_OPT_PRIM_UNKNOWN;
+                opt.in_begin = 0U;
+            }
+            opt.state_known = 0U;
+            break;
+        case DL_BITMAP_SOURCE:
+        case DL_BITMAP_LAYOUT:
+        case DL_BITMAP_SIZE:
+        case DL_BITMAP_LAYOUT_H:
+        case DL_BITMAP_SIZE_H:
+#if EVE_GEN > 2
+        case DL_BITMAP_EXT_FORMAT:
+        case DL_BITMAP_SWIZZLE:
+#endif
+            emit(word); /* per bitmap handle */
+            break;
+        default:
+            if (opcode >= DL_OPT_OPCODES)
+            {
+                emit(word);
+                opt.state_known = 0U;
+            }
+            else if ((state_is_known(opcode) == 0U) || (opt.state[opcode] != word))
+            {
+                emit(word);
+                opt.state[opcode] = word;
+                opt.state_known |= 1ULL << opcode;
+            }
+            else
+            {
+                /* already set */
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Optimise a list of display list and coprocessor commands in place before it is sent.
+ * @return The new number of words, the list is not changed when it has CALL, JUMP or RETURN.
+ * @note The list needs to be in RAM, in the format for EVE_cmd_static_list().
+ */
+uint16_t EVE_dl_optimize(uint32_t *p_list, uint16_t num)
+{
+    uint16_t index = 0U;
+    uint16_t stop = num;
+
+    if (NULL == p_list)
+    {
+        return (num);
+    }
+
+    /* removing words would move the targets of CALL and JUMP */
+    while (index < num)
+    {
+        uint32_t const word = p_list[index];
+
+        if ((word & 0xFF000000UL) == 0xFF000000UL)
+        {
+            uint16_t const len = command_length(p_list, index, num);
+
+            if (0U == len)
+            {
+                stop = index;
+                break;
+            }
+            index += len;
+        }
+        else if (((word & 0xC0000000UL) == 0U) && (((word & 0xFF000000UL) == DL_CALL) ||
+                 ((word & 0xFF000000UL) == DL_JUMP) || ((word & 0xFF000000UL) == DL_RETURN)))
+        {
+            return (num);
+        }
+        else
+        {
+            index++;
+        }
+    }
+
+    opt.p_list = p_list;
+    opt.out = 0U;
+    opt.current.pending_end = 0U;
+    reset_state(0U);
+
+    index = 0U;
+    while (index < stop)
+    {
+        uint32_t const word = p_list[index];
+
+        if ((word & 0xFF000000UL) == 0xFF000000UL)
+        {
+            uint16_t const len = command_length(p_list, index, num);
+
+            flush_end();
+            for (uint16_t count = 0U; count < len; count++)
+            {
+                emit(p_list[index + count]);
+            }
+            index += len;
+            reset_state((uint8_t) (CMD_DLSTART == word));
+        }
+        else if ((word & 0xC0000000UL) != 0U)
+        {
+            flush_end();
+            emit(vertex2ii(word));
+            opt.current.vertices++;
+            opt.new_vertices++;
+            index++;
+        }
+        else
+        {
+            if ((word & 0xFF000000UL) == DL_BEGIN)
+            {
+                begin(word);
+            }
+            else if ((word & 0xFF000000UL) == DL_END)
+            {
+                end();
+            }
+            else
+            {
+                state(word);
+            }
+            index++;
+        }
+    }
+    flush_end();
+
+    /* the part after a command with data of unknown length */
+    while (index < num)
+    {
+        emit(p_list[index]);
+        index++;
+    }
+
+    return (opt.out);
+}
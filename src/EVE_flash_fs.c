@@ -0,0 +1,199 @@
+/*
+@file    EVE_flash_fs.c
+@brief   find assets in the external flash of BT81x by name instead of by hard-coded offsets
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+The flash image is built with tools/eve_flash_pack.c, it puts a sorted index of
+the assets right behind the blob. EVE_flash_fs_init() copies the index once from
+the flash to RAM_G, a lookup is a binary search over the name hashes in RAM_G
+with one 32 bit read per step and one read of the matching entry.
+
+if (E_OK == EVE_init_flash())
+{
+    EVE_flash_fs_init(EVE_RAM_G_SIZE - 4096UL);
+    EVE_flash_fs_load("font_l1.raw", MEM_FONT, NULL);
+}
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#include "EVE_flash_fs.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+#if EVE_GEN > 2
+
+static uint32_t fs_ram_index = 0UL;
+static uint16_t fs_count = 0U;
+
+static uint32_t get_u32(const uint8_t *p_data)
+{
+    return (((uint32_t) p_data[0U]) | (((uint32_t) p_data[1U]) << 8U) |
+            (((uint32_t) p_data[2U]) << 16U) | (((uint32_t) p_data[3U]) << 24U));
+}
+
+/**
+ * @brief 32 bit FNV-1a hash of an asset name, the same as used by tools/eve_flash_pack.c.
+ */
+uint32_t EVE_flash_fs_hash(const char *p_name)
+{
+    uint32_t hash = 0x811C9DC5UL;
+
+    if (p_name != NULL)
+    {
+        const uint8_t *const p_bytes = (const uint8_t *) p_name;
+
+        for (uint16_t index = 0U; p_bytes[index] != 0U; index++)
+        {
+            hash ^= p_bytes[index];
+            hash *= 0x01000193UL;
+        }
+    }
+    return (hash);
+}
+
+/**
+ * @brief Copy the index of the flash image to RAM_G at "ram_index".
+ * @note - Needs to be called after EVE_init_flash() returned E_OK.
+ * @note - "ram_index" needs to be 4-byte aligned and the index needs 16 + 32 bytes per asset.
+ * @return Returns E_OK when a valid index was found.
+ */
+uint8_t EVE_flash_fs_init(uint32_t ram_index)
+{
+    uint8_t ret = E_NOT_OK;
+
+    fs_count = 0U;
+    fs_ram_index = ram_index;
+
+    EVE_cmd_flashread(ram_index, EVE_FLASH_FS_INDEX, 64UL);
+
+    if (EVE_FLASH_FS_MAGIC == EVE_memRead32(ram_index))
+    {
+        uint32_t count = EVE_memRead32(ram_index + 4UL);
+        uint32_t length = EVE_FLASH_FS_HEADER_SIZE + (count * EVE_FLASH_FS_ENTRY_SIZE);
+
+        if ((count > 0UL) && (count < 0x10000UL) && ((ram_index + length) <= EVE_RAM_G_SIZE))
+        {
+            if (length > 64UL)
+            {
+                EVE_cmd_flashread(ram_index, EVE_FLASH_FS_INDEX, length);
+            }
+            fs_count = (uint16_t) count;
+            ret = E_OK;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Number of assets in the index, zero if EVE_flash_fs_init() did not find one.
+ */
+uint16_t EVE_flash_fs_count(void)
+{
+    return (fs_count);
+}
+
+/**
+ * @brief Find an asset by name in the index.
+ * @return Returns E_OK and fills in "p_asset" if the asset was found.
+ */
+uint8_t EVE_flash_fs_find(const char *p_name, EVE_flash_asset *p_asset)
+{
+    uint8_t ret = E_NOT_OK;
+    uint32_t hash = EVE_flash_fs_hash(p_name);
+    uint16_t first = 0U;
+    uint16_t last = fs_count;
+
+    while (first < last)
+    {
+        uint16_t middle = first + ((last - first) / 2U);
+        uint32_t entry = fs_ram_index + EVE_FLASH_FS_HEADER_SIZE + (((uint32_t) middle) * EVE_FLASH_FS_ENTRY_SIZE);
+        uint32_t entry_hash = EVE_memRead32(entry);
+
+        if (entry_hash == hash)
+        {
+            if (p_asset != NULL)
+            {
+                uint8_t data[EVE_FLASH_FS_ENTRY_SIZE];
+
+                EVE_memRead_sram_buffer(entry, data, EVE_FLASH_FS_ENTRY_SIZE);
+                p_asset->offset = get_u32(&data[4U]);
+                p_asset->size = get_u32(&data[8U]);
+                p_asset->crc = get_u32(&data[12U]);
+                p_asset->format = get_u32(&data[16U]);
+                p_asset->ram_size = get_u32(&data[20U]);
+                p_asset->width = (uint16_t) (get_u32(&data[24U]) & 0xFFFFUL);
+                p_asset->height = (uint16_t) (get_u32(&data[24U]) >> 16U);
+            }
+            ret = E_OK;
+            break;
+        }
+
+        if (entry_hash < hash)
+        {
+            first = middle + 1U;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Find an asset by name and copy it from the flash to RAM_G at "dest" with one CMD_FLASHREAD.
+ * @note - "dest" needs to be 4-byte aligned, "p_asset" is optional and can be NULL.
+ */
+uint8_t EVE_flash_fs_load(const char *p_name, uint32_t dest, EVE_flash_asset *p_asset)
+{
+    EVE_flash_asset asset;
+    uint8_t ret;
+
+    ret = EVE_flash_fs_find(p_name, &asset);
+    if (E_OK == ret)
+    {
+        EVE_cmd_flashread(dest, asset.offset, asset.size);
+        if (p_asset != NULL)
+        {
+            *p_asset = asset;
+        }
+    }
+    return (ret);
+}
+
+#endif /* EVE_GEN > 2 */
@@ -0,0 +1,83 @@
+/*
+@file    EVE_flash_fs.h
+@brief   prototypes and definitions for the asset index in the external flash of BT81x
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_FLASH_FS_H
+#define EVE_FLASH_FS_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if EVE_GEN > 2
+
+/* the index follows the 4096 bytes blob at the start of the flash, all values are 32 bit little endian
+   header: magic, number of entries, reserved, reserved
+   entries sorted by name hash: hash, offset, size, crc, format, ram_size, width | height << 16, reserved */
+#define EVE_FLASH_FS_MAGIC 0x53465645UL /* "EVFS" */
+#define EVE_FLASH_FS_INDEX 4096UL /* address of the index in the flash */
+#define EVE_FLASH_FS_HEADER_SIZE 16UL
+#define EVE_FLASH_FS_ENTRY_SIZE 32UL
+#define EVE_FLASH_FS_RAW 0xFFFFFFFFUL /* format of assets that are not bitmaps */
+
+typedef struct
+{
+    uint32_t offset;   /* address in the flash, 64 byte aligned */
+    uint32_t size;     /* number of bytes in the flash, a multiple of 4 */
+    uint32_t crc;      /* CRC-32 of the data as calculated by EVE_cmd_memcrc() */
+    uint32_t format;   /* bitmap format or EVE_FLASH_FS_RAW */
+    uint32_t ram_size; /* number of bytes in RAM_G after loading, for example after inflating */
+    uint16_t width;
+    uint16_t height;
+} EVE_flash_asset;
+
+uint32_t EVE_flash_fs_hash(const char *p_name);
+uint8_t EVE_flash_fs_init(uint32_t ram_index);
+uint16_t EVE_flash_fs_count(void);
+uint8_t EVE_flash_fs_find(const char *p_name, EVE_flash_asset *p_asset);
+uint8_t EVE_flash_fs_load(const char *p_name, uint32_t dest, EVE_flash_asset *p_asset);
+
+#endif /* EVE_GEN > 2 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_FLASH_FS_H */
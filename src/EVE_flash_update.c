@@ -0,0 +1,247 @@
+/*
+@file    EVE_flash_update.c
+@brief   resumable and verified update of the external flash of BT81x
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+EVE_cmd_flashwrite() and EVE_cmd_flashupdate() send the data thru the command FIFO
+and wait for the coprocessor every 3840 bytes. EVE_flash_update_run() instead works
+on 4096 byte sectors with three buffers in RAM_G:
+- the next sector is written directly to RAM_G while the coprocessor is still
+  programming the previous sector from the other buffer
+- the CRC of the sector in the flash is calculated with CMD_FLASHREAD + CMD_MEMCRC
+  in the third buffer, sectors that already have the CRC of the source are skipped
+  without sending them to CMD_FLASHUPDATE
+- the CRC of every programmed sector is verified the same way
+- "next_sector" is only advanced for verified or skipped sectors and reported to
+  the optional journal function, so an interrupted update can be resumed
+
+The flash needs to be in full mode, so EVE_init_flash() needs to be called first.
+
+@section History
+
+5.0
+- initial version
+- fix: check for coprocessor faults and the alignment of the flash address
+
+*/
+
+#include "EVE_flash_update.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+#if EVE_GEN > 2
+
+/* CRC-32 as calculated by CMD_MEMCRC, with a table for 4 bits at a time */
+static uint32_t crc32_update(uint32_t crc, const uint8_t *p_data, uint16_t len)
+{
+    static const uint32_t table[16U] =
+    {
+        0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL, 0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+        0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL, 0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+    };
+    uint32_t value = crc;
+
+    for (uint16_t index = 0U; index < len; index++)
+    {
+        value ^= p_data[index];
+        value = (value >> 4U) ^ table[value & 0x0FUL];
+        value = (value >> 4U) ^ table[value & 0x0FUL];
+    }
+    return (value);
+}
+
+/* queue a coprocessor command with three parameters without waiting for it */
+static void queue_cmd(uint32_t command, uint32_t param1, uint32_t param2, uint32_t param3)
+{
+    EVE_cmd_dl(command);
+    EVE_cmd_dl(param1);
+    EVE_cmd_dl(param2);
+    EVE_cmd_dl(param3);
+}
+
+/* queue the CRC calculation of a flash sector, returns the offset of the result in RAM_CMD */
+static uint16_t queue_flash_crc(uint32_t flash_address, uint32_t ram_crc)
+{
+    queue_cmd(CMD_FLASHREAD, ram_crc, flash_address, EVE_FLASH_SECTOR_SIZE);
+    queue_cmd(CMD_MEMCRC, ram_crc, EVE_FLASH_SECTOR_SIZE, 0UL);
+    return ((uint16_t) ((EVE_memRead16(REG_CMD_WRITE) - 4U) & 0x0FFFU));
+}
+
+/* write one sector from the source to RAM_G, returns E_OK and the CRC of the sector */
+static uint8_t upload_sector(const EVE_flash_update *p_update, uint32_t sector, uint32_t ram_dest, uint32_t *p_crc)
+{
+    uint8_t buffer[EVE_FLASH_UPDATE_CHUNK];
+    uint8_t ret = E_OK;
+    uint32_t crc = 0xFFFFFFFFUL;
+    uint32_t offset = sector * EVE_FLASH_SECTOR_SIZE;
+
+    for (uint32_t done = 0UL; (done < EVE_FLASH_SECTOR_SIZE) && (E_OK == ret); done += EVE_FLASH_UPDATE_CHUNK)
+    {
+        uint32_t available = 0UL;
+
+        if ((offset + done) < p_update->size)
+        {
+            available = p_update->size - (offset + done);
+        }
+
+        if (available >= EVE_FLASH_UPDATE_CHUNK)
+        {
+            ret = p_update->p_source(offset + done, buffer, EVE_FLASH_UPDATE_CHUNK);
+        }
+        else
+        {
+            if (available > 0UL)
+            {
+                ret = p_update->p_source(offset + done, buffer, (uint16_t) available);
+            }
+            for (uint32_t index = available; index < EVE_FLASH_UPDATE_CHUNK; index++)
+            {
+                buffer[index] = 0xFFU; /* as erased */
+            }
+        }
+
+        crc = crc32_update(crc, buffer, EVE_FLASH_UPDATE_CHUNK);
+        EVE_memWrite_sram_buffer(ram_dest + done, buffer, EVE_FLASH_UPDATE_CHUNK);
+    }
+
+    *p_crc = ~crc;
+    return (ret);
+}
+
+static void advance_journal(EVE_flash_update *p_update, uint32_t sector)
+{
+    p_update->next_sector = sector + 1UL;
+    if (p_update->p_journal != NULL)
+    {
+        p_update->p_journal(p_update);
+    }
+}
+
+/**
+ * @brief Write an image to the flash, skip unchanged sectors, verify the programmed ones.
+ * @note - Blocks until the update is done, this can take a while for large images.
+ * @note - Set "next_sector" to the value stored by the journal function to resume an interrupted update.
+ * @return Returns E_OK on success, E_NOT_OK if the source failed, the flash address is not 4096 byte aligned,
+ * the RAM_G buffer is not 4 byte aligned or the coprocessor ran into a fault, EVE_FAIL_FLASH_VERIFY if a sector
+ * did not have the expected CRC after programming, "next_sector" is the sector to resume with.
+ */
+uint8_t EVE_flash_update_run(EVE_flash_update *p_update)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if ((p_update != NULL) && (p_update->p_source != NULL) &&
+        (0UL == (p_update->flash_address & (EVE_FLASH_SECTOR_SIZE - 1UL))) && (0UL == (p_update->ram_buffer & 3UL)))
+    {
+        uint32_t num_sectors = (p_update->size + EVE_FLASH_SECTOR_SIZE - 1UL) / EVE_FLASH_SECTOR_SIZE;
+        uint32_t ram_crc = p_update->ram_buffer + (2UL * EVE_FLASH_SECTOR_SIZE);
+        uint32_t sector = p_update->next_sector;
+        uint8_t buffer_index = 0U;
+        uint8_t pending = 0U; /* a sector was sent to CMD_FLASHUPDATE and is not verified yet */
+        uint32_t pending_sector = 0UL;
+        uint32_t pending_crc = 0UL;
+
+        ret = E_OK;
+        (void) EVE_get_and_reset_fault_state(); /* only faults of this update count */
+        p_update->sectors_written = 0UL;
+        p_update->sectors_skipped = 0UL;
+
+        while ((E_OK == ret) && ((sector < num_sectors) || (pending != 0U)))
+        {
+            uint32_t ram_sector = p_update->ram_buffer + (((uint32_t) buffer_index) * EVE_FLASH_SECTOR_SIZE);
+            uint32_t crc = 0UL;
+            uint16_t verify_offset = 0U;
+            uint16_t compare_offset = 0U;
+
+            /* the coprocessor may still be programming the pending sector from the other buffer */
+            if (sector < num_sectors)
+            {
+                ret = upload_sector(p_update, sector, ram_sector, &crc);
+            }
+
+            if (E_OK == ret)
+            {
+                if (pending != 0U)
+                {
+                    verify_offset = queue_flash_crc(p_update->flash_address + (pending_sector * EVE_FLASH_SECTOR_SIZE), ram_crc);
+                }
+                if (sector < num_sectors)
+                {
+                    compare_offset = queue_flash_crc(p_update->flash_address + (sector * EVE_FLASH_SECTOR_SIZE), ram_crc);
+                }
+                EVE_execute_cmd();
+
+                /* this also covers the CMD_FLASHUPDATE of the pending sector, the results in RAM_CMD are lost then */
+                if (EVE_get_and_reset_fault_state() != E_OK)
+                {
+                    ret = E_NOT_OK;
+                }
+                else if (pending != 0U)
+                {
+                    pending = 0U;
+                    if (EVE_memRead32(EVE_RAM_CMD + verify_offset) == pending_crc)
+                    {
+                        advance_journal(p_update, pending_sector);
+                    }
+                    else
+                    {
+                        ret = EVE_FAIL_FLASH_VERIFY;
+                    }
+                }
+            }
+
+            if ((E_OK == ret) && (sector < num_sectors))
+            {
+                if (EVE_memRead32(EVE_RAM_CMD + compare_offset) == crc)
+                {
+                    p_update->sectors_skipped++;
+                    advance_journal(p_update, sector);
+                }
+                else
+                {
+                    queue_cmd(CMD_FLASHUPDATE, p_update->flash_address + (sector * EVE_FLASH_SECTOR_SIZE),
+                              ram_sector, EVE_FLASH_SECTOR_SIZE);
+                    p_update->sectors_written++;
+                    pending = 1U;
+                    pending_sector = sector;
+                    pending_crc = crc;
+                    buffer_index ^= 1U;
+                }
+                sector++;
+            }
+        }
+    }
+
+    return (ret);
+}
+
+#endif /* EVE_GEN > 2 */
@@ -0,0 +1,86 @@
+/*
+@file    EVE_flash_update.h
+@brief   prototypes and definitions for updating the external flash of BT81x
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_FLASH_UPDATE_H
+#define EVE_FLASH_UPDATE_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if EVE_GEN > 2
+
+#define EVE_FLASH_SECTOR_SIZE 4096UL
+
+/* size of the buffer on the host the source data is read into */
+#if !defined (EVE_FLASH_UPDATE_CHUNK)
+#define EVE_FLASH_UPDATE_CHUNK 256U
+#endif
+
+typedef struct EVE_flash_update_s EVE_flash_update;
+
+/* read "len" bytes of the image at "offset" into "p_data", returns E_OK on success */
+typedef uint8_t (*EVE_flash_source)(uint32_t offset, uint8_t *p_data, uint16_t len);
+
+/* called whenever next_sector advanced, to store it in a non-volatile place */
+typedef void (*EVE_flash_journal)(const EVE_flash_update *p_update);
+
+struct EVE_flash_update_s
+{
+    uint32_t flash_address;   /* destination in the flash, 4096 byte aligned */
+    uint32_t size;            /* size of the image, the rest of the last sector is filled with 0xff */
+    uint32_t ram_buffer;      /* 3 * 4096 bytes of RAM_G, 4 byte aligned */
+    uint32_t next_sector;     /* first sector not yet verified, 0 to start over or the stored value to resume */
+    uint32_t sectors_written; /* statistics */
+    uint32_t sectors_skipped;
+    EVE_flash_source p_source;
+    EVE_flash_journal p_journal; /* optional */
+};
+
+uint8_t EVE_flash_update_run(EVE_flash_update *p_update);
+
+#endif /* EVE_GEN > 2 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_FLASH_UPDATE_H */
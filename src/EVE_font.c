@@ -0,0 +1,236 @@
+/*
+@file    EVE_font.c
+@brief   host-side font metrics to measure, wrap and truncate strings without asking the coprocessor
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+The metrics block of a font is read once with a single burst read and kept in an
+EVE_font_metrics struct, all further calculations run on the host.
+Only the legacy font format is supported, that is the ROM fonts 16...34 and the
+fonts set up with EVE_cmd_setfont() / EVE_cmd_setfont2(), not the extended fonts of BT81x.
+
+static EVE_font_metrics font_28;
+
+EVE_font_load_rom(&font_28, 28U);
+xpos = EVE_HSIZE - 10 - EVE_font_string_width(&font_28, "Speed");
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#include "EVE_font.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+#define FONT_OFFSET_FORMAT 128U
+#define FONT_OFFSET_STRIDE 132U
+#define FONT_OFFSET_WIDTH 136U
+#define FONT_OFFSET_HEIGHT 140U
+#define FONT_OFFSET_GLYPHS 144U
+
+static uint32_t get_u32(const uint8_t *p_data)
+{
+    return (((uint32_t) p_data[0U]) | (((uint32_t) p_data[1U]) << 8U) |
+            (((uint32_t) p_data[2U]) << 16U) | (((uint32_t) p_data[3U]) << 24U));
+}
+
+static uint8_t char_width(const EVE_font_metrics *p_font, uint8_t data)
+{
+    uint8_t width = 0U;
+
+    if (data < 128U)
+    {
+        width = p_font->widths[data];
+    }
+    return (width);
+}
+
+/**
+ * @brief Read the metrics block of a legacy font from RAM_G or ROM with a single burst read.
+ * @note - "ptr" is the address that was used with EVE_cmd_setfont() / EVE_cmd_setfont2().
+ * @note - Returns E_NOT_OK for blocks that do not look like a legacy font, like BT81x extended fonts.
+ */
+uint8_t EVE_font_load_ram(EVE_font_metrics *p_font, uint32_t ptr)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if (p_font != NULL)
+    {
+        uint8_t block[EVE_FONT_TABLE_SIZE];
+        uint32_t height;
+
+        EVE_memRead_sram_buffer(ptr, block, EVE_FONT_TABLE_SIZE);
+
+        for (uint8_t index = 0U; index < 128U; index++)
+        {
+            p_font->widths[index] = block[index];
+        }
+
+        p_font->format = get_u32(&block[FONT_OFFSET_FORMAT]);
+        p_font->stride = get_u32(&block[FONT_OFFSET_STRIDE]);
+        p_font->max_width = (uint16_t) get_u32(&block[FONT_OFFSET_WIDTH]);
+        height = get_u32(&block[FONT_OFFSET_HEIGHT]);
+        p_font->height = (uint16_t) height;
+        p_font->glyphs = get_u32(&block[FONT_OFFSET_GLYPHS]);
+
+        if ((height > 0U) && (height < 256U))
+        {
+            ret = E_OK;
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Read the metrics block of one of the ROM fonts 16...34 with a single burst read.
+ * @note - "romslot" is the same number that is used with EVE_cmd_romfont().
+ */
+uint8_t EVE_font_load_rom(EVE_font_metrics *p_font, uint8_t romslot)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if ((romslot > 15U) && (romslot < 35U))
+    {
+        uint32_t root;
+
+        root = EVE_memRead32(EVE_ROM_FONTROOT);
+        ret = EVE_font_load_ram(p_font, root + (EVE_FONT_TABLE_SIZE * ((uint32_t) romslot - 16UL)));
+    }
+    return (ret);
+}
+
+/**
+ * @brief Calculate the width in pixels of a string as it is drawn by EVE_cmd_text() without options.
+ */
+uint16_t EVE_font_string_width(const EVE_font_metrics *p_font, const char *p_text)
+{
+    uint16_t width = 0U;
+
+    if ((p_font != NULL) && (p_text != NULL))
+    {
+        const uint8_t *const p_bytes = (const uint8_t *) p_text;
+
+        for (uint16_t index = 0U; p_bytes[index] != 0U; index++)
+        {
+            width += char_width(p_font, p_bytes[index]);
+        }
+    }
+    return (width);
+}
+
+/**
+ * @brief Get the number of characters of a string that fit into "max_width" pixels, to truncate a string.
+ */
+uint16_t EVE_font_fit(const EVE_font_metrics *p_font, const char *p_text, uint16_t max_width)
+{
+    uint16_t index = 0U;
+
+    if ((p_font != NULL) && (p_text != NULL))
+    {
+        const uint8_t *const p_bytes = (const uint8_t *) p_text;
+        uint16_t width = 0U;
+
+        while (p_bytes[index] != 0U)
+        {
+            width += char_width(p_font, p_bytes[index]);
+            if (width > max_width)
+            {
+                break;
+            }
+            index++;
+        }
+    }
+    return (index);
+}
+
+/**
+ * @brief Get the number of characters for the next line of a string that is wrapped at "max_width" pixels.
+ * @note - Lines are broken after the last space that fits or at a newline, words that are longer than a line are
+ * broken at the last character that fits.
+ * @note - The returned length includes the space or newline the line is broken at, so it can be used
+ * to advance to the next line directly. At least one character is returned as long as the string is not empty.
+ */
+uint16_t EVE_font_wrap(const EVE_font_metrics *p_font, const char *p_text, uint16_t max_width)
+{
+    uint16_t length = 0U;
+
+    if ((p_font != NULL) && (p_text != NULL))
+    {
+        const uint8_t *const p_bytes = (const uint8_t *) p_text;
+        uint16_t width = 0U;
+        uint16_t index = 0U;
+        uint16_t last_space = 0U;
+
+        while ((p_bytes[index] != 0U) && (0U == length))
+        {
+            uint8_t data = p_bytes[index];
+
+            if ((uint8_t) '\n' == data)
+            {
+                length = index + 1U;
+            }
+            else
+            {
+                width += char_width(p_font, data);
+
+                if (width > max_width)
+                {
+                    if (last_space > 0U)
+                    {
+                        length = last_space;
+                    }
+                    else
+                    {
+                        length = (index > 0U) ? index : 1U;
+                    }
+                }
+                else
+                {
+                    if ((uint8_t) ' ' == data)
+                    {
+                        last_space = index + 1U;
+                    }
+                    index++;
+                }
+            }
+        }
+
+        if (0U == length)
+        {
+            length = index; /* the rest of the string fits */
+        }
+    }
+    return (length);
+}
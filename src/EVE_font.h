@@ -0,0 +1,71 @@
+/*
+@file    EVE_font.h
+@brief   prototypes for the host-side font metrics functions
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_FONT_H
+#define EVE_FONT_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* copy of the metrics block of a legacy font, as used by the ROM fonts and by fonts for EVE_cmd_setfont2() */
+typedef struct
+{
+    uint8_t widths[128U]; /* width in pixels of the characters 0...127 */
+    uint32_t format;      /* bitmap format of the glyphs */
+    uint32_t stride;      /* line stride of a glyph in bytes */
+    uint16_t max_width;   /* width of the widest glyph */
+    uint16_t height;      /* height of a line of text */
+    uint32_t glyphs;      /* address of the glyph data */
+} EVE_font_metrics;
+
+uint8_t EVE_font_load_rom(EVE_font_metrics *p_font, uint8_t romslot);
+uint8_t EVE_font_load_ram(EVE_font_metrics *p_font, uint32_t ptr);
+
+uint16_t EVE_font_string_width(const EVE_font_metrics *p_font, const char *p_text);
+uint16_t EVE_font_fit(const EVE_font_metrics *p_font, const char *p_text, uint16_t max_width);
+uint16_t EVE_font_wrap(const EVE_font_metrics *p_font, const char *p_text, uint16_t max_width);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_FONT_H */
@@ -0,0 +1,342 @@
+/*
+@file    EVE_gesture.c
+@brief   sliders, dials and scroll areas from the touch tracker of EVE with momentum in fixed point
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+CMD_TRACK makes EVE track the touch on an area with a tag, the position along a linear
+area or the angle around the center of a rotary area is reported in REG_TRACKER
+for the first touch and REG_TRACKER_1...4 for the other touches, as value 0...65535
+in the upper 16 bits and the tag in the lower 8 bits.
+EVE_gesture_update() reads all five registers with a single transfer and maps them to
+the value range of each region, no touch coordinates need to be processed on the MCU.
+
+Scroll regions are linear regions with the scroll offset as value: the content follows
+the finger while touched and keeps moving with the speed of the last moves after the
+release, the speed is reduced by EVE_GESTURE_FRICTION every millisecond.
+All of it is 16.16 fixed point, the tracker value times the length of the region
+is already the distance in pixels in 16.16.
+
+The regions are set up once, outside of display list building as CMD_TRACK waits
+for the coprocessor, the objects need to be drawn with the same tag in every display list:
+
+EVE_gesture_add(EVE_GESTURE_LINEAR, 20U, 20, 200, 300, 20, 0, 100);
+EVE_gesture_add(EVE_GESTURE_ROTARY, 21U, 600, 240, 1U, 1U, 0, 359);
+EVE_gesture_add(EVE_GESTURE_SCROLL, 22U, 0, 0, 400, 480, 0, list_height - 480);
+...
+EVE_gesture_update(systick_ms);
+EVE_cmd_slider(20, 200, 300, 20, 0, EVE_gesture_value(20U), 100);
+
+For rotary regions the width and height have to be 1.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#include "EVE_gesture.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+#define GESTURE_TRACKERS 5U
+#define GESTURE_MAX_STEP 100UL /* ms of physics per update at most */
+
+typedef struct
+{
+    int32_t min;
+    int32_t max;
+    int32_t position;  /* 16.16, scroll offset or mapped value */
+    int32_t speed;     /* 16.16 pixels per ms, scroll regions only */
+    uint32_t last_time;
+    uint16_t length;   /* of the longer side */
+    uint16_t last_track;
+    uint8_t tag;       /* 0 for an unused region */
+    uint8_t type;
+    uint8_t touched;
+} gesture_region;
+
+static gesture_region regions[EVE_GESTURE_REGIONS];
+
+static gesture_region *find_region(uint8_t tag)
+{
+    gesture_region *p_ret = NULL;
+
+    for (uint8_t index = 0U; index < EVE_GESTURE_REGIONS; index++)
+    {
+        if ((tag != 0U) && (regions[index].tag == tag))
+        {
+            p_ret = &regions[index];
+            break;
+        }
+    }
+    return (p_ret);
+}
+
+static gesture_region *find_region_free(void)
+{
+    gesture_region *p_ret = NULL;
+
+    for (uint8_t index = 0U; index < EVE_GESTURE_REGIONS; index++)
+    {
+        if (0U == regions[index].tag)
+        {
+            p_ret = &regions[index];
+            break;
+        }
+    }
+    return (p_ret);
+}
+
+static int32_t clamp(const gesture_region *p_region, int32_t position)
+{
+    int32_t ret = position;
+
+    if (ret < (p_region->min * 65536L))
+    {
+        ret = p_region->min * 65536L;
+    }
+    if (ret > (p_region->max * 65536L))
+    {
+        ret = p_region->max * 65536L;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Set up a region with CMD_TRACK, the value starts at min.
+ * @return E_OK, E_NOT_OK when the tag is 0 or all EVE_GESTURE_REGIONS are in use
+ * @note Waits for the coprocessor, not to be used while building a display list.
+ * @note A region with a tag that is already set up is replaced.
+ * @note min and max need to be in the range of -32768...32767 as the value is kept in 16.16.
+ */
+uint8_t EVE_gesture_add(uint8_t type, uint8_t tag, int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
+                        int32_t min, int32_t max)
+{
+    gesture_region *p_region = find_region(tag);
+    uint8_t ret = E_NOT_OK;
+
+    if (NULL == p_region)
+    {
+        p_region = find_region_free();
+    }
+
+    if ((tag != 0U) && (p_region != NULL))
+    {
+        p_region->min = min;
+        p_region->max = (max > min) ? max : min;
+        p_region->position = min * 65536L;
+        p_region->speed = 0L;
+        p_region->length = (wid > hgt) ? wid : hgt;
+        p_region->tag = tag;
+        p_region->type = type;
+        p_region->touched = 0U;
+        EVE_cmd_track(xc0, yc0, wid, hgt, tag);
+        ret = E_OK;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Stop tracking a region.
+ * @note Waits for the coprocessor, not to be used while building a display list.
+ */
+void EVE_gesture_remove(uint8_t tag)
+{
+    gesture_region *p_region = find_region(tag);
+
+    if (p_region != NULL)
+    {
+        EVE_cmd_track(0, 0, 0U, 0U, tag);
+        p_region->tag = 0U;
+    }
+}
+
+static void update_region(gesture_region *p_region, uint32_t tracker, uint32_t time_ms)
+{
+    uint16_t const track = (uint16_t) (tracker >> 16U);
+    uint32_t elapsed = time_ms - p_region->last_time;
+
+    if (elapsed > GESTURE_MAX_STEP)
+    {
+        elapsed = GESTURE_MAX_STEP;
+    }
+
+    if (p_region->type != EVE_GESTURE_SCROLL)
+    {
+        if (tracker != 0U)
+        {
+            int64_t const range = (int64_t) p_region->max - (int64_t) p_region->min;
+
+            p_region->position = (int32_t) (((int64_t) p_region->min * 65536LL) + ((range * 65536LL * track) / 65535LL));
+        }
+        p_region->touched = (uint8_t) (tracker != 0U);
+    }
+    else if (tracker != 0U)
+    {
+        if (0U == p_region->touched)
+        {
+            p_region->speed = 0L;
+        }
+        else
+        {
+            /* the content follows the finger, moving the finger down scrolls up */
+            int32_t const moved = -((int32_t) track - (int32_t) p_region->last_track) * (int32_t) p_region->length;
+
+            p_region->position = clamp(p_region, p_region->position + moved);
+            if (elapsed > 0U)
+            {
+                p_region->speed = (p_region->speed + (moved / (int32_t) elapsed)) / 2L;
+            }
+        }
+        p_region->last_track = track;
+        p_region->touched = 1U;
+    }
+    else
+    {
+        /* released, the fling slows down */
+        p_region->touched = 0U;
+        for (uint32_t step = 0U; (step < elapsed) && (p_region->speed != 0L); step++)
+        {
+            int32_t const position = clamp(p_region, p_region->position + p_region->speed);
+
+            if (position != (p_region->position + p_region->speed))
+            {
+                p_region->speed = 0L; /* hit the end */
+            }
+            else
+            {
+                p_region->speed = (int32_t) (((int64_t) p_region->speed * EVE_GESTURE_FRICTION) / 65536LL);
+                if ((p_region->speed < EVE_GESTURE_MIN_SPEED) && (p_region->speed > -EVE_GESTURE_MIN_SPEED))
+                {
+                    p_region->speed = 0L;
+                }
+            }
+            p_region->position = position;
+        }
+    }
+    p_region->last_time = time_ms;
+}
+
+/**
+ * @brief Read REG_TRACKER to REG_TRACKER_4 with a single transfer and update all regions.
+ * @return E_OK, E_NOT_OK when a DMA transfer is still running
+ * @note Call this regularly, for example once per frame, the time is used for the scroll speed.
+ */
+uint8_t EVE_gesture_update(uint32_t time_ms)
+{
+    uint8_t ret = E_NOT_OK;
+
+#if defined (EVE_DMA)
+    if (0 == EVE_dma_busy)
+    {
+#endif
+    uint8_t buffer[GESTURE_TRACKERS * 4U];
+
+    EVE_memRead_sram_buffer(REG_TRACKER, buffer, GESTURE_TRACKERS * 4U);
+
+    for (uint8_t index = 0U; index < EVE_GESTURE_REGIONS; index++)
+    {
+        gesture_region *p_region = &regions[index];
+        uint32_t tracker = 0UL;
+
+        if (0U == p_region->tag)
+        {
+            continue;
+        }
+
+        /* the first touch on the region */
+        for (uint8_t touch = 0U; touch < GESTURE_TRACKERS; touch++)
+        {
+            const uint8_t *p_bytes = &buffer[touch * 4U];
+
+            if (p_bytes[0U] == p_region->tag)
+            {
+                tracker = ((uint32_t) p_bytes[0U]) | (((uint32_t) p_bytes[1U]) << 8U) |
+                          (((uint32_t) p_bytes[2U]) << 16U) | (((uint32_t) p_bytes[3U]) << 24U);
+                break;
+            }
+        }
+        update_region(p_region, tracker, time_ms);
+    }
+    ret = E_OK;
+
+#if defined (EVE_DMA)
+    }
+#endif
+    return (ret);
+}
+
+/**
+ * @brief The value of a region, in the range it was set up with, 0 for an unknown tag.
+ */
+int32_t EVE_gesture_value(uint8_t tag)
+{
+    const gesture_region *p_region = find_region(tag);
+    int32_t ret = 0L;
+
+    if (p_region != NULL)
+    {
+        ret = (p_region->position + 32768L) / 65536L;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Set the value of a region, for example to scroll to a position, stops a fling.
+ */
+void EVE_gesture_set_value(uint8_t tag, int32_t value)
+{
+    gesture_region *p_region = find_region(tag);
+
+    if (p_region != NULL)
+    {
+        p_region->position = clamp(p_region, value * 65536L);
+        p_region->speed = 0L;
+    }
+}
+
+/**
+ * @brief Returns 1 while a region is touched or a scroll region is still moving, to keep the screen updated.
+ */
+uint8_t EVE_gesture_is_active(uint8_t tag)
+{
+    const gesture_region *p_region = find_region(tag);
+    uint8_t ret = 0U;
+
+    if (p_region != NULL)
+    {
+        ret = (uint8_t) ((p_region->touched != 0U) || (p_region->speed != 0L));
+    }
+    return (ret);
+}
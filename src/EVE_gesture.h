@@ -0,0 +1,78 @@
+/*
+@file    EVE_gesture.h
+@brief   sliders, dials and scroll areas from the touch tracker of EVE with momentum in fixed point
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_GESTURE_H
+#define EVE_GESTURE_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* you may define these in your build-environment to use different settings */
+#if !defined (EVE_GESTURE_REGIONS)
+#define EVE_GESTURE_REGIONS 8U
+#endif
+
+#if !defined (EVE_GESTURE_FRICTION)
+#define EVE_GESTURE_FRICTION 65208L /* speed kept per ms after a fling, 0.995 in 16.16 */
+#endif
+
+#if !defined (EVE_GESTURE_MIN_SPEED)
+#define EVE_GESTURE_MIN_SPEED 655L /* a fling stops below this speed, 0.01 pixels per ms in 16.16 */
+#endif
+
+#define EVE_GESTURE_LINEAR 0U /* slider, the value follows the position along the longer side */
+#define EVE_GESTURE_ROTARY 1U /* dial, the value follows the angle around x, y */
+#define EVE_GESTURE_SCROLL 2U /* the value is a scroll offset in pixels that is dragged and keeps moving after release */
+
+uint8_t EVE_gesture_add(uint8_t type, uint8_t tag, int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
+                        int32_t min, int32_t max);
+void EVE_gesture_remove(uint8_t tag);
+uint8_t EVE_gesture_update(uint32_t time_ms);
+int32_t EVE_gesture_value(uint8_t tag);
+void EVE_gesture_set_value(uint8_t tag, int32_t value);
+uint8_t EVE_gesture_is_active(uint8_t tag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_GESTURE_H */
@@ -0,0 +1,257 @@
+/*
+@file    EVE_mediafifo.c
+@brief   feeding the media FIFO from a callback, for example to inflate data streamed from a SD card
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+The media FIFO is a ring buffer in RAM_G that the coprocessor reads from for commands
+that are given the option EVE_OPT_MEDIAFIFO, like CMD_INFLATE2, CMD_LOADIMAGE and CMD_PLAYVIDEO.
+EVE_mediafifo_fill() does not wait for anything, it asks the source callback for as much data
+as fits into the free space and then moves REG_MEDIAFIFO_WRITE.
+The MCU only needs EVE_MEDIAFIFO_CHUNK bytes of buffer regardless of the size of the stream.
+
+The end of a stream is padded with zeros to a multiple of 4 bytes.
+
+EVE_mediafifo_init(MEM_FIFO, 16384UL);
+EVE_inflate_stream(MEM_PIC1, read_from_sd);
+
+@section History
+
+5.0
+- initial version
+- fix: EVE_inflate_stream() resets the coprocessor and the media FIFO when the stream was truncated
+
+*/
+
+#include "EVE_mediafifo.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+static uint32_t fifo_address = 0UL;
+static uint32_t fifo_size = 0UL;
+static uint32_t fifo_write = 0UL; /* offset in the FIFO, mirrors REG_MEDIAFIFO_WRITE */
+static uint8_t fifo_end = 0U;
+
+static uint8_t fifo_buffer[EVE_MEDIAFIFO_CHUNK];
+
+/**
+ * @brief Set up the media FIFO with CMD_MEDIAFIFO and start a new stream.
+ * @note The size should be a multiple of 4, this waits for the coprocessor.
+ */
+void EVE_mediafifo_init(uint32_t address, uint32_t size)
+{
+    EVE_cmd_mediafifo(address, size);
+
+    fifo_address = address;
+    fifo_size = size & ~3UL;
+    fifo_write = EVE_memRead32(REG_MEDIAFIFO_READ);
+    EVE_memWrite32(REG_MEDIAFIFO_WRITE, fifo_write);
+    fifo_end = 0U;
+}
+
+/**
+ * @brief Get the number of bytes that can be written to the media FIFO right now.
+ * @note One word is kept free, a full FIFO would look empty to the coprocessor.
+ */
+uint32_t EVE_mediafifo_space(void)
+{
+    uint32_t const fifo_read = EVE_memRead32(REG_MEDIAFIFO_READ);
+    uint32_t used;
+    uint32_t ret = 0UL;
+
+    if (fifo_write >= fifo_read)
+    {
+        used = fifo_write - fifo_read;
+    }
+    else
+    {
+        used = fifo_size - fifo_read + fifo_write;
+    }
+
+    if ((used + 4UL) < fifo_size)
+    {
+        ret = fifo_size - used - 4UL;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Write up to "max" bytes from the source to the media FIFO, without waiting for the coprocessor.
+ * @note - Stops when the FIFO is full or the source reports the end of the stream.
+ * @note - Does nothing while a DMA transfer is active.
+ * @return the number of bytes written
+ */
+uint32_t EVE_mediafifo_fill(EVE_media_source p_source, uint32_t max)
+{
+    uint32_t sent = 0UL;
+
+#if defined (EVE_DMA)
+    if (0 == EVE_dma_busy)
+    {
+#endif
+    uint32_t space = EVE_mediafifo_space();
+
+    while ((0U == fifo_end) && (space >= 4UL) && (sent < max))
+    {
+        uint32_t len = space;
+        uint32_t got;
+        uint32_t first;
+
+        if (len > EVE_MEDIAFIFO_CHUNK)
+        {
+            len = EVE_MEDIAFIFO_CHUNK;
+        }
+        if (len > (max - sent))
+        {
+            len = max - sent;
+        }
+        len &= ~3UL;
+
+        if (0UL == len)
+        {
+            break;
+        }
+
+        got = p_source(fifo_buffer, len);
+
+        if (got < len)
+        {
+            fifo_end = 1U;
+            while ((got & 3UL) != 0UL)
+            {
+                fifo_buffer[got] = 0U;
+                got++;
+            }
+        }
+
+        first = fifo_size - fifo_write;
+        if (got <= first)
+        {
+            EVE_memWrite_sram_buffer(fifo_address + fifo_write, fifo_buffer, got);
+        }
+        else
+        {
+            EVE_memWrite_sram_buffer(fifo_address + fifo_write, fifo_buffer, first);
+            EVE_memWrite_sram_buffer(fifo_address, &fifo_buffer[first], got - first);
+        }
+
+        fifo_write = (fifo_write + got) % fifo_size;
+        space -= got;
+        sent += got;
+    }
+
+    if (sent != 0UL)
+    {
+        EVE_memWrite32(REG_MEDIAFIFO_WRITE, fifo_write);
+    }
+#if defined (EVE_DMA)
+    }
+#endif
+
+    return (sent);
+}
+
+/**
+ * @brief Check if the source reported the end of the stream.
+ */
+uint8_t EVE_mediafifo_is_end(void)
+{
+    return (fifo_end);
+}
+
+/**
+ * @brief Check if the coprocessor has read everything that was written to the media FIFO.
+ */
+uint8_t EVE_mediafifo_is_empty(void)
+{
+    uint8_t ret = 0U;
+
+    if (EVE_memRead32(REG_MEDIAFIFO_READ) == fifo_write)
+    {
+        ret = 1U;
+    }
+    return (ret);
+}
+
+#if EVE_GEN > 2
+
+/**
+ * @brief Inflate a zlib stream from the source to RAM_G thru the media FIFO with CMD_INFLATE2.
+ * @note The coprocessor decompresses while the next chunks are fetched from the source.
+ * @note EVE_mediafifo_init() must be called first, this waits for the coprocessor to finish.
+ * @return E_OK on success, EVE_FAULT_RECOVERED if the coprocessor reported a fault,
+ * @return E_NOT_OK if the coprocessor is still waiting for data after the end of the stream,
+ * @return the stream was truncated then and the coprocessor is reset with EVE_coprocessor_reset()
+ */
+uint8_t EVE_inflate_stream(uint32_t dest, EVE_media_source p_source)
+{
+    uint8_t ret = EVE_IS_BUSY;
+    uint16_t timeout = 0U;
+
+    fifo_end = 0U;
+    EVE_cmd_inflate2(dest, (uint32_t) EVE_OPT_MEDIAFIFO, NULL, 0UL);
+
+    while (EVE_IS_BUSY == ret)
+    {
+        if (0U == fifo_end)
+        {
+            (void) EVE_mediafifo_fill(p_source, 0xFFFFFFFFUL);
+        }
+
+        ret = EVE_busy();
+
+        if (EVE_FIFO_HALF_EMPTY == ret)
+        {
+            ret = EVE_IS_BUSY;
+        }
+
+        if ((EVE_IS_BUSY == ret) && (fifo_end != 0U) && (EVE_mediafifo_is_empty() != 0U))
+        {
+            if (timeout >= EVE_MEDIAFIFO_TIMEOUT)
+            {
+                EVE_coprocessor_reset(); /* CMD_INFLATE2 would wait for more data forever */
+                fifo_write = EVE_memRead32(REG_MEDIAFIFO_READ);
+                EVE_memWrite32(REG_MEDIAFIFO_WRITE, fifo_write);
+                fifo_end = 0U;
+                ret = E_NOT_OK;
+            }
+            else
+            {
+                DELAY_MS(1U);
+                timeout++;
+            }
+        }
+    }
+    return (ret);
+}
+
+#endif /* EVE_GEN > 2 */
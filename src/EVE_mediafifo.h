@@ -0,0 +1,78 @@
+/*
+@file    EVE_mediafifo.h
+@brief   prototypes and definitions for feeding the media FIFO from a callback
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_MEDIAFIFO_H
+#define EVE_MEDIAFIFO_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* you may define these in your build-environment to use different settings */
+#if !defined (EVE_MEDIAFIFO_CHUNK)
+#define EVE_MEDIAFIFO_CHUNK 512U /* size of the buffer the source callback fills, a multiple of 4 */
+#endif
+
+#if !defined (EVE_MEDIAFIFO_TIMEOUT)
+#define EVE_MEDIAFIFO_TIMEOUT 100U /* ms to wait for the coprocessor after all data was consumed */
+#endif
+
+/**
+ * @brief Callback that provides the next bytes of a stream.
+ * @return the number of bytes put into p_buffer, less than len only at the end of the stream
+ */
+typedef uint32_t (*EVE_media_source)(uint8_t *p_buffer, uint32_t len);
+
+void EVE_mediafifo_init(uint32_t address, uint32_t size);
+uint32_t EVE_mediafifo_space(void);
+uint32_t EVE_mediafifo_fill(EVE_media_source p_source, uint32_t max);
+uint8_t EVE_mediafifo_is_end(void);
+uint8_t EVE_mediafifo_is_empty(void);
+
+#if EVE_GEN > 2
+uint8_t EVE_inflate_stream(uint32_t dest, EVE_media_source p_source);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_MEDIAFIFO_H */
@@ -0,0 +1,268 @@
+/*
+@file    EVE_prefetch.c
+@brief   load assets from the flash of BT81x to RAM_G in the background, a slice per frame
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+EVE_cmd_flashread() waits for the coprocessor to finish the copy, for a couple of
+hundred kB this stalls the display for several frames.
+Here the requests are split into chunks of up to EVE_PREFETCH_CHUNK bytes and each
+call of EVE_prefetch_service() only puts "budget" bytes worth of CMD_FLASHREAD into
+the command FIFO, behind the commands of the current frame.
+Completion is tracked by comparing REG_CMD_READ with the FIFO position of each
+CMD_FLASHREAD, nothing is waited for.
+
+The budget is in bytes as the time CMD_FLASHREAD needs depends on the flash and
+the flash mode, measure it once for the flash you are using.
+
+slot = EVE_prefetch_queue(MEM_PIC_NEXT, asset.offset, asset.size);
+...
+TFT_display(); // the frame for the current screen, ends with CMD_SWAP
+EVE_prefetch_service(32768UL);
+...
+if (EVE_prefetch_is_done(slot)) { EVE_prefetch_release(slot); show the next screen }
+
+A slot stays done until it is released, EVE_prefetch_queue() only uses free slots.
+
+@section History
+
+5.0
+- initial version
+- fix: only reuse slots that were released with EVE_prefetch_release()
+
+*/
+
+#include "EVE_prefetch.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+#if EVE_GEN > 2
+
+#define SLOT_FREE 0U
+#define SLOT_QUEUED 1U
+#define SLOT_DONE 2U
+
+typedef struct
+{
+    uint32_t dest;
+    uint32_t src;
+    uint32_t remaining; /* bytes not yet sent to the coprocessor */
+    uint8_t inflight;   /* number of chunks in the command FIFO */
+    uint8_t state;
+} prefetch_slot_t;
+
+typedef struct
+{
+    uint16_t end; /* REG_CMD_WRITE after the command */
+    uint8_t slot;
+} prefetch_chunk_t;
+
+static prefetch_slot_t slots[EVE_PREFETCH_SLOTS];
+static prefetch_chunk_t chunks[EVE_PREFETCH_INFLIGHT];
+static uint8_t chunk_first = 0U;
+static uint8_t chunk_count = 0U;
+
+/**
+ * @brief Queue a copy of "num" bytes from the flash at "src" to RAM_G at "dest".
+ * @note - "src" needs to be 64-byte aligned and "dest" 4-byte aligned, "num" is rounded up to a multiple of 4.
+ * @return Returns the slot to check with EVE_prefetch_is_done() or EVE_PREFETCH_NONE if all slots are in use.
+ * @note - The slot is in use until it is given back with EVE_prefetch_release().
+ */
+uint8_t EVE_prefetch_queue(uint32_t dest, uint32_t src, uint32_t num)
+{
+    uint8_t ret = EVE_PREFETCH_NONE;
+
+    for (uint8_t index = 0U; index < EVE_PREFETCH_SLOTS; index++)
+    {
+        if (SLOT_FREE == slots[index].state)
+        {
+            slots[index].dest = dest;
+            slots[index].src = src;
+            slots[index].remaining = (num + 3UL) & ~3UL;
+            slots[index].inflight = 0U;
+            slots[index].state = SLOT_QUEUED;
+            ret = index;
+            break;
+        }
+    }
+    return (ret);
+}
+
+/* retire all chunks the coprocessor is done with */
+static void retire_chunks(void)
+{
+    uint8_t data[8U];
+    uint16_t cmd_read;
+    uint16_t cmd_write;
+    uint16_t fifo_used;
+
+    EVE_memRead_sram_buffer(REG_CMD_READ, data, 8U); /* REG_CMD_READ and REG_CMD_WRITE in one go */
+    cmd_read = (uint16_t) ((((uint16_t) data[1U]) << 8U) | data[0U]) & 0x0FFFU;
+    cmd_write = (uint16_t) ((((uint16_t) data[5U]) << 8U) | data[4U]) & 0x0FFFU;
+    fifo_used = (cmd_write - cmd_read) & 0x0FFFU;
+
+    while (chunk_count > 0U)
+    {
+        prefetch_chunk_t *p_chunk = &chunks[chunk_first];
+
+        /* the chunk is still in the FIFO as long as its end is between REG_CMD_READ and REG_CMD_WRITE */
+        if (((uint16_t) ((cmd_write - p_chunk->end) & 0x0FFFU)) < fifo_used)
+        {
+            break;
+        }
+
+        slots[p_chunk->slot].inflight--;
+        if ((0U == slots[p_chunk->slot].inflight) && (0UL == slots[p_chunk->slot].remaining))
+        {
+            slots[p_chunk->slot].state = SLOT_DONE;
+        }
+        chunk_first = (uint8_t) ((chunk_first + 1U) % EVE_PREFETCH_INFLIGHT);
+        chunk_count--;
+    }
+}
+
+/**
+ * @brief Check for finished copies and send up to "budget" bytes of new CMD_FLASHREAD to the coprocessor.
+ * @note - To be called once per frame after the display list of the frame was sent.
+ * @note - Does nothing while a DMA transfer is active.
+ * @return Returns the number of requests that are not done yet.
+ */
+uint8_t EVE_prefetch_service(uint32_t budget)
+{
+#if defined (EVE_DMA)
+    if (0 == EVE_dma_busy)
+    {
+#endif
+    uint32_t budget_left = budget;
+
+    if (chunk_count > 0U)
+    {
+        retire_chunks();
+    }
+
+    for (uint8_t index = 0U; (index < EVE_PREFETCH_SLOTS) && (budget_left > 0UL); index++)
+    {
+        prefetch_slot_t *p_slot = &slots[index];
+
+        while ((SLOT_QUEUED == p_slot->state) && (p_slot->remaining > 0UL) &&
+               (budget_left > 0UL) && (chunk_count < EVE_PREFETCH_INFLIGHT))
+        {
+            uint32_t num = p_slot->remaining;
+            prefetch_chunk_t *p_chunk;
+
+            if (num > EVE_PREFETCH_CHUNK)
+            {
+                num = EVE_PREFETCH_CHUNK;
+            }
+            if (num > budget_left)
+            {
+                if (budget_left < 64UL)
+                {
+                    break;
+                }
+                num = budget_left & ~63UL; /* keep "src" of the next chunk 64-byte aligned */
+            }
+
+            EVE_cmd_dl(CMD_FLASHREAD);
+            EVE_cmd_dl(p_slot->dest);
+            EVE_cmd_dl(p_slot->src);
+            EVE_cmd_dl(num);
+
+            p_chunk = &chunks[(chunk_first + chunk_count) % EVE_PREFETCH_INFLIGHT];
+            p_chunk->end = EVE_memRead16(REG_CMD_WRITE) & 0x0FFFU;
+            p_chunk->slot = index;
+            chunk_count++;
+
+            p_slot->inflight++;
+            p_slot->dest += num;
+            p_slot->src += num;
+            p_slot->remaining -= num;
+            budget_left = (num < budget_left) ? (budget_left - num) : 0UL;
+        }
+    }
+#if defined (EVE_DMA)
+    }
+#endif
+
+    return (EVE_prefetch_pending());
+}
+
+/**
+ * @brief Check if the request in "slot" is completely in RAM_G.
+ * @note - A slot that is done stays done until EVE_prefetch_release() is called for it.
+ */
+uint8_t EVE_prefetch_is_done(uint8_t slot)
+{
+    uint8_t ret = 0U;
+
+    if ((slot < EVE_PREFETCH_SLOTS) && (SLOT_DONE == slots[slot].state))
+    {
+        ret = 1U;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Give back a slot after EVE_prefetch_is_done() reported it as done.
+ * @note - Slots that are still queued are not touched, the coprocessor may still write to them.
+ * @return Returns E_OK or E_NOT_OK if "slot" is not done.
+ */
+uint8_t EVE_prefetch_release(uint8_t slot)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if ((slot < EVE_PREFETCH_SLOTS) && (SLOT_DONE == slots[slot].state))
+    {
+        slots[slot].state = SLOT_FREE;
+        ret = E_OK;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Number of requests that are not done yet.
+ */
+uint8_t EVE_prefetch_pending(void)
+{
+    uint8_t pending = 0U;
+
+    for (uint8_t index = 0U; index < EVE_PREFETCH_SLOTS; index++)
+    {
+        if (SLOT_QUEUED == slots[index].state)
+        {
+            pending++;
+        }
+    }
+    return (pending);
+}
+
+#endif /* EVE_GEN > 2 */
@@ -0,0 +1,79 @@
+/*
+@file    EVE_prefetch.h
+@brief   prototypes and definitions for loading assets from the flash of BT81x in the background
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+- fix: added EVE_prefetch_release()
+
+*/
+
+#ifndef EVE_PREFETCH_H
+#define EVE_PREFETCH_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if EVE_GEN > 2
+
+/* you may define these in your build-environment to use different settings */
+#if !defined (EVE_PREFETCH_SLOTS)
+#define EVE_PREFETCH_SLOTS 8U /* number of requests that can be queued */
+#endif
+
+#if !defined (EVE_PREFETCH_CHUNK)
+#define EVE_PREFETCH_CHUNK 16384UL /* largest single CMD_FLASHREAD, a multiple of 64 */
+#endif
+
+#if !defined (EVE_PREFETCH_INFLIGHT)
+#define EVE_PREFETCH_INFLIGHT 8U /* number of CMD_FLASHREAD in the command FIFO at a time */
+#endif
+
+#define EVE_PREFETCH_NONE 0xFFU
+
+uint8_t EVE_prefetch_queue(uint32_t dest, uint32_t src, uint32_t num);
+uint8_t EVE_prefetch_service(uint32_t budget);
+uint8_t EVE_prefetch_is_done(uint8_t slot);
+uint8_t EVE_prefetch_release(uint8_t slot);
+uint8_t EVE_prefetch_pending(void);
+
+#endif /* EVE_GEN > 2 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_PREFETCH_H */
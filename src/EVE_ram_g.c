@@ -0,0 +1,190 @@
+/*
+@file    EVE_ram_g.c
+@brief   a simple allocator for RAM_G
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+This keeps track of which part of RAM_G is used for what, the memory itself is never touched.
+The managed area is given to EVE_ram_g_init(), usually everything after the static
+assets of an application, all blocks are aligned to 64 bytes which is sufficient for
+every bitmap format, CMD_FLASHREAD and CMD_SNAPSHOT2.
+The bookkeeping is a fixed table of EVE_RAM_G_BLOCKS entries sorted by address,
+freed blocks are merged with their free neighbours.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#include "EVE_ram_g.h"
+
+typedef struct
+{
+    uint32_t address;
+    uint32_t size;
+    uint8_t used;
+} ram_g_block_t;
+
+static ram_g_block_t ram_g_blocks[EVE_RAM_G_BLOCKS];
+static uint8_t ram_g_count = 0U;
+
+static void block_remove(uint8_t index)
+{
+    for (uint8_t idx = index; idx < (ram_g_count - 1U); idx++)
+    {
+        ram_g_blocks[idx] = ram_g_blocks[idx + 1U];
+    }
+    ram_g_count--;
+}
+
+/**
+ * @brief Set the area of RAM_G that is managed, this forgets all previous allocations.
+ */
+void EVE_ram_g_init(uint32_t start, uint32_t size)
+{
+    uint32_t const first = (start + EVE_RAM_G_ALIGN - 1UL) & ~(EVE_RAM_G_ALIGN - 1UL);
+    uint32_t const end = start + size;
+
+    ram_g_count = 0U;
+
+    if (end > first)
+    {
+        ram_g_blocks[0].address = first;
+        ram_g_blocks[0].size = (end - first) & ~(EVE_RAM_G_ALIGN - 1UL);
+        ram_g_blocks[0].used = 0U;
+        if (ram_g_blocks[0].size != 0UL)
+        {
+            ram_g_count = 1U;
+        }
+    }
+}
+
+/**
+ * @brief Allocate a block with at least "size" bytes, first fit.
+ * @return the address in RAM_G, EVE_RAM_G_NONE if there is no free block large enough
+ * @note When the table is full the whole free block is used instead of splitting it.
+ */
+uint32_t EVE_ram_g_alloc(uint32_t size)
+{
+    uint32_t const needed = (size + EVE_RAM_G_ALIGN - 1UL) & ~(EVE_RAM_G_ALIGN - 1UL);
+    uint32_t ret = EVE_RAM_G_NONE;
+
+    if (needed != 0UL)
+    {
+        for (uint8_t idx = 0U; idx < ram_g_count; idx++)
+        {
+            ram_g_block_t *p_block = &ram_g_blocks[idx];
+
+            if ((0U == p_block->used) && (p_block->size >= needed))
+            {
+                if ((p_block->size > needed) && (ram_g_count < EVE_RAM_G_BLOCKS))
+                {
+                    for (uint8_t move = ram_g_count; move > (idx + 1U); move--)
+                    {
+                        ram_g_blocks[move] = ram_g_blocks[move - 1U];
+                    }
+                    ram_g_blocks[idx + 1U].address = p_block->address + needed;
+                    ram_g_blocks[idx + 1U].size = p_block->size - needed;
+                    ram_g_blocks[idx + 1U].used = 0U;
+                    p_block->size = needed;
+                    ram_g_count++;
+                }
+                p_block->used = 1U;
+                ret = p_block->address;
+                break;
+            }
+        }
+    }
+    return (ret);
+}
+
+/**
+ * @brief Release a block returned by EVE_ram_g_alloc(), unknown addresses are ignored.
+ */
+void EVE_ram_g_free(uint32_t address)
+{
+    for (uint8_t idx = 0U; idx < ram_g_count; idx++)
+    {
+        if ((ram_g_blocks[idx].address == address) && (ram_g_blocks[idx].used != 0U))
+        {
+            uint8_t index = idx;
+
+            ram_g_blocks[index].used = 0U;
+
+            if (((index + 1U) < ram_g_count) && (0U == ram_g_blocks[index + 1U].used))
+            {
+                ram_g_blocks[index].size += ram_g_blocks[index + 1U].size;
+                block_remove(index + 1U);
+            }
+
+            if ((index > 0U) && (0U == ram_g_blocks[index - 1U].used))
+            {
+                ram_g_blocks[index - 1U].size += ram_g_blocks[index].size;
+                block_remove(index);
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Get the sum of all free blocks.
+ */
+uint32_t EVE_ram_g_available(void)
+{
+    uint32_t sum = 0UL;
+
+    for (uint8_t idx = 0U; idx < ram_g_count; idx++)
+    {
+        if (0U == ram_g_blocks[idx].used)
+        {
+            sum += ram_g_blocks[idx].size;
+        }
+    }
+    return (sum);
+}
+
+/**
+ * @brief Get the size of the largest free block, the most that a single allocation can get.
+ */
+uint32_t EVE_ram_g_largest(void)
+{
+    uint32_t largest = 0UL;
+
+    for (uint8_t idx = 0U; idx < ram_g_count; idx++)
+    {
+        if ((0U == ram_g_blocks[idx].used) && (ram_g_blocks[idx].size > largest))
+        {
+            largest = ram_g_blocks[idx].size;
+        }
+    }
+    return (largest);
+}
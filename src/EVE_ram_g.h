@@ -0,0 +1,66 @@
+/*
+@file    EVE_ram_g.h
+@brief   prototypes and definitions for a simple allocator for RAM_G
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_RAM_G_H
+#define EVE_RAM_G_H
+
+#include "EVE.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* you may define this in your build-environment to use a different setting */
+#if !defined (EVE_RAM_G_BLOCKS)
+#define EVE_RAM_G_BLOCKS 32U /* maximum number of free and used blocks the managed area can be split into */
+#endif
+
+#define EVE_RAM_G_ALIGN 64UL /* all blocks start on and are sized in multiples of this */
+#define EVE_RAM_G_NONE 0xFFFFFFFFUL /* returned when an allocation fails */
+
+void EVE_ram_g_init(uint32_t start, uint32_t size);
+uint32_t EVE_ram_g_alloc(uint32_t size);
+void EVE_ram_g_free(uint32_t address);
+uint32_t EVE_ram_g_available(void);
+uint32_t EVE_ram_g_largest(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_RAM_G_H */
@@ -0,0 +1,179 @@
+/*
+@file    EVE_sound.c
+@brief   sound-effect sequencer for the synthesizer that does not wait and writes as part of the display list
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+A pattern is a table of steps with sound, note, volume and duration, four bytes each.
+EVE_sound_tick() is called while the display list is built, when a step is due it adds
+a CMD_MEMWRITE for REG_VOL_SOUND, REG_SOUND and REG_PLAY to the coprocessor list.
+These three registers are next to each other, so a step is six words in the transfer
+that is sent anyways and there are no extra SPI transfers, no delays and no polling of REG_PLAY.
+The timing comes from the durations of the steps, the steps start with the frame that follows,
+so the resolution is one frame.
+When steps were missed only the last one that is due is played and the timing does not drift.
+
+static const EVE_sound_step alarm[] =
+{
+    {EVE_SQUAREWAVE, EVE_MIDI_A5, 0xFFU, 20U},
+    {EVE_SILENCE, 0U, 0xFFU, 10U},
+    {EVE_SQUAREWAVE, EVE_MIDI_E5, 0xFFU, 20U},
+    {EVE_SILENCE, 0U, 0xFFU, 50U},
+};
+
+EVE_sound_start(alarm, 4U, 0U, systick_ms);
+...
+EVE_start_cmd_burst();
+EVE_cmd_dl_burst(CMD_DLSTART);
+(void) EVE_sound_tick(systick_ms);
+...
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#include "EVE_sound.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+static const EVE_sound_step *sound_pattern = NULL;
+static uint32_t sound_next = 0UL; /* time the next step is due */
+static uint8_t sound_steps = 0U;
+static uint8_t sound_index = 0U;
+static uint8_t sound_repeat = 0U; /* patterns left to play, 0 for forever */
+static uint8_t sound_active = 0U;
+static uint8_t sound_stop = 0U;
+static uint8_t sound_volume = 0U;
+
+/**
+ * @brief Start to play a pattern of "steps" steps, the first one with the next EVE_sound_tick().
+ * @param repeat how often the pattern is played, 0 to play it until EVE_sound_stop()
+ */
+void EVE_sound_start(const EVE_sound_step *p_pattern, uint8_t steps, uint8_t repeat, uint32_t time_ms)
+{
+    if ((p_pattern != NULL) && (steps != 0U))
+    {
+        sound_pattern = p_pattern;
+        sound_steps = steps;
+        sound_index = 0U;
+        sound_repeat = repeat;
+        sound_next = time_ms;
+        sound_active = 1U;
+        sound_stop = 0U;
+    }
+}
+
+/**
+ * @brief Stop the pattern, the synthesizer is set to silence with the next EVE_sound_tick().
+ */
+void EVE_sound_stop(void)
+{
+    if (sound_active != 0U)
+    {
+        sound_active = 0U;
+        sound_stop = 1U;
+    }
+}
+
+/* CMD_MEMWRITE thru the coprocessor, works with and without burst-mode */
+static void sound_write(uint8_t sound, uint8_t note, uint8_t volume)
+{
+    EVE_cmd_dl(CMD_MEMWRITE);
+    EVE_cmd_dl(REG_VOL_SOUND);
+    EVE_cmd_dl(12UL); /* REG_VOL_SOUND, REG_SOUND and REG_PLAY */
+    EVE_cmd_dl((uint32_t) volume);
+    EVE_cmd_dl((((uint32_t) note) << 8U) | ((uint32_t) sound));
+    EVE_cmd_dl(1UL);
+}
+
+/**
+ * @brief Add the writes for the step that is due to the coprocessor list, to be called while building a display list.
+ * @note Works with and without burst-mode, adds nothing when no step is due.
+ * @return 1 while a pattern is playing
+ */
+uint8_t EVE_sound_tick(uint32_t time_ms)
+{
+    const EVE_sound_step *p_step = NULL;
+
+    while ((sound_active != 0U) && (((int32_t) (time_ms - sound_next)) >= 0L))
+    {
+        if (sound_index == sound_steps)
+        {
+            sound_index = 0U;
+            if (sound_repeat != 0U)
+            {
+                sound_repeat--;
+                if (0U == sound_repeat)
+                {
+                    sound_active = 0U;
+                    sound_stop = 1U;
+                }
+            }
+        }
+
+        if (sound_active != 0U)
+        {
+            uint8_t const duration = sound_pattern[sound_index].duration;
+
+            p_step = &sound_pattern[sound_index];
+            sound_next += ((duration != 0U) ? (uint32_t) duration : 1UL) * EVE_SOUND_TICK_MS;
+            sound_index++;
+        }
+    }
+
+    if (sound_stop != 0U)
+    {
+        sound_stop = 0U;
+        sound_write(EVE_SILENCE, 0U, sound_volume);
+    }
+    else if (p_step != NULL)
+    {
+        sound_volume = p_step->volume;
+        sound_write(p_step->sound, p_step->note, p_step->volume);
+    }
+    else
+    {
+        /* nothing due */
+    }
+    return (sound_active);
+}
+
+/**
+ * @brief Check if a pattern is playing.
+ */
+uint8_t EVE_sound_is_playing(void)
+{
+    return (sound_active);
+}
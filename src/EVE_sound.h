@@ -0,0 +1,71 @@
+/*
+@file    EVE_sound.h
+@brief   sound-effect sequencer for the synthesizer that does not wait and writes as part of the display list
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_SOUND_H
+#define EVE_SOUND_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* you may define these in your build-environment to use different settings */
+#if !defined (EVE_SOUND_TICK_MS)
+#define EVE_SOUND_TICK_MS 10U /* unit of the duration of a step */
+#endif
+
+typedef struct
+{
+    uint8_t sound;    /* REG_SOUND instrument or effect, EVE_SILENCE...EVE_CHACK */
+    uint8_t note;     /* MIDI note, EVE_MIDI_A0...EVE_MIDI_C8, only for instruments with a pitch */
+    uint8_t volume;   /* REG_VOL_SOUND */
+    uint8_t duration; /* time until the next step in units of EVE_SOUND_TICK_MS */
+} EVE_sound_step;
+
+void EVE_sound_start(const EVE_sound_step *p_pattern, uint8_t steps, uint8_t repeat, uint32_t time_ms);
+void EVE_sound_stop(void);
+uint8_t EVE_sound_tick(uint32_t time_ms);
+uint8_t EVE_sound_is_playing(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_SOUND_H */
@@ -0,0 +1,90 @@
+/*
+@file    EVE_sprite.c
+@brief   drawing the cells of a bitmap atlas with one bitmap handle
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+An atlas is a bitmap with all icons stacked as cells of the same size, as written
+by tools/eve_img_convert with more than one image.
+The bitmap handle is set up once per display list with EVE_sprite_sheet_setup(),
+after that every icon is a single VERTEX2II with the cell number, instead of
+BITMAP_SOURCE, BITMAP_LAYOUT, BITMAP_SIZE and a vertex for each separate bitmap.
+Only icons outside of 0...511 need three words: BITMAP_HANDLE, CELL and VERTEX2F.
+
+static const EVE_sprite_sheet icons = {MEM_ICONS, ICONS_FORMAT, ICONS_WIDTH, ICONS_HEIGHT, 5U, ICONS_CELLS};
+
+EVE_sprite_sheet_setup(&icons);
+EVE_cmd_dl_burst(DL_BEGIN | EVE_BITMAPS);
+EVE_sprite_draw(&icons, ICONS_CELL_HOME, 10, 10);
+EVE_sprite_draw(&icons, ICONS_CELL_BACK, 80, 10);
+EVE_cmd_dl_burst(DL_END);
+
+@section History
+
+5.0
+- initial version
+- fix: EVE_sprite_draw() does not draw cells above EVE_SPRITE_MAX_CELLS - 1, CELL() only has 7 bits
+
+*/
+
+#include "EVE_sprite.h"
+
+/**
+ * @brief Set up the bitmap handle of the atlas with CMD_SETBITMAP, once per display list.
+ * @note The layout height is the height of one cell, that is what makes the cells work.
+ * @note Works with and without burst-mode, just like EVE_cmd_setbitmap().
+ */
+void EVE_sprite_sheet_setup(const EVE_sprite_sheet *p_sheet)
+{
+    EVE_cmd_dl(BITMAP_HANDLE(p_sheet->handle));
+    EVE_cmd_setbitmap(p_sheet->address, p_sheet->format, p_sheet->width, p_sheet->height);
+}
+
+/**
+ * @brief Draw one cell of the atlas, needs to be between BEGIN(BITMAPS) and END.
+ * @note One VERTEX2II for coordinates 0...511, BITMAP_HANDLE, CELL and VERTEX2F otherwise.
+ * @note Cells that are not in the atlas or that are not below EVE_SPRITE_MAX_CELLS are not drawn.
+ */
+void EVE_sprite_draw(const EVE_sprite_sheet *p_sheet, uint8_t cell, int16_t xc0, int16_t yc0)
+{
+    if ((cell >= p_sheet->cells) || (cell >= EVE_SPRITE_MAX_CELLS))
+    {
+        /* nothing to draw */
+    }
+    else if ((xc0 >= 0) && (xc0 < 512) && (yc0 >= 0) && (yc0 < 512))
+    {
+        EVE_cmd_dl(VERTEX2II((uint16_t) xc0, (uint16_t) yc0, p_sheet->handle, cell));
+    }
+    else
+    {
+        EVE_cmd_dl(BITMAP_HANDLE(p_sheet->handle));
+        EVE_cmd_dl(CELL(cell));
+        EVE_cmd_dl(VERTEX2F((int16_t) (xc0 * (1 << EVE_SPRITE_FRAC)), (int16_t) (yc0 * (1 << EVE_SPRITE_FRAC))));
+    }
+}
@@ -0,0 +1,73 @@
+/*
+@file    EVE_sprite.h
+@brief   prototypes and definitions for drawing the cells of a bitmap atlas
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_SPRITE_H
+#define EVE_SPRITE_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* you may define this in your build-environment to use a different setting */
+#if !defined (EVE_SPRITE_FRAC)
+#define EVE_SPRITE_FRAC 0U /* has to match the VERTEX_FORMAT() of the display list, 0 is full pixels */
+#endif
+
+#define EVE_SPRITE_MAX_CELLS 128U /* CELL() and VERTEX2II() have 7 bits for the cell */
+
+typedef struct
+{
+    uint32_t address; /* of cell 0 in RAM_G */
+    uint16_t format;
+    uint16_t width;   /* of one cell */
+    uint16_t height;  /* of one cell */
+    uint8_t handle;
+    uint8_t cells;    /* up to EVE_SPRITE_MAX_CELLS */
+} EVE_sprite_sheet;
+
+void EVE_sprite_sheet_setup(const EVE_sprite_sheet *p_sheet);
+void EVE_sprite_draw(const EVE_sprite_sheet *p_sheet, uint8_t cell, int16_t xc0, int16_t yc0);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_SPRITE_H */
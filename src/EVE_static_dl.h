@@ -0,0 +1,257 @@
+/*
+@file    EVE_static_dl.h
+@brief   constant expression macros to build display-lists and command-lists at compile time
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+The macros in EVE.h were converted to static inline functions for type-safety,
+but these can not be used to initialize a const array.
+The macros in this file are constant expressions, so a static screen can be put
+together as a table that is fully encoded by the compiler and located in FLASH:
+
+static const uint32_t static_background[] =
+{
+    CMD_DLSTART,
+    DL_TAG,
+    EVE_DL_CMD_BGCOLOR(0x00c0c0c0UL),
+    DL_VERTEX_FORMAT,
+    EVE_DL_BEGIN(EVE_RECTS),
+    EVE_DL_LINE_WIDTH(16U),
+    EVE_DL_COLOR_RGB(0x5dade2UL),
+    DL_VERTEX2F,
+    EVE_DL_VERTEX2F(EVE_HSIZE, 64),
+    DL_END,
+    EVE_DL_CMD_TEXT(10, EVE_VSIZE - 50, 26, 0),
+    EVE_DL_CHARS('D', 'L', '-', 's'), EVE_DL_CHARS('i', 'z', 'e', ':'), EVE_DL_CHARS(0, 0, 0, 0)
+};
+
+EVE_cmd_static_list(static_background, EVE_STATIC_LIST_SIZE(static_background));
+
+Strings need to be given as four characters per word with at least one trailing zero.
+When compiling C++14 or newer the class EVE_static_list<> can be used instead,
+it takes strings as they are and pads them in constexpr context:
+
+static constexpr EVE_static_list<32U> make_background()
+{
+    EVE_static_list<32U> list;
+    list.dl(CMD_DLSTART).bgcolor(0x00c0c0c0UL).text(10, EVE_VSIZE - 50, 26, 0, "DL-size:");
+    return (list);
+}
+static constexpr EVE_static_list<32U> static_background = make_background();
+
+EVE_cmd_static_list(static_background.words, static_background.num_words);
+
+@section History
+
+5.0
+- initial version
+- added EVE_TEXT_HANDLE() to set up an EVE_text_handle at compile time
+- fix: EVE_TEXT_HANDLE() marks the table as in_flash so it is read with fetch_flash_byte() on AVR
+
+*/
+
+#ifndef EVE_STATIC_DL_H
+#define EVE_STATIC_DL_H
+
+#include "EVE_commands.h"
+
+/* number of 32 bit words in a static list array */
+#define EVE_STATIC_LIST_SIZE(list) ((uint16_t) (sizeof(list) / sizeof((list)[0U])))
+
+/* ##################################################################
+    display list commands
+##################################################################### */
+
+#define EVE_DL_ALPHA_FUNC(func, ref) ((DL_ALPHA_FUNC) | ((((uint32_t) (func)) & 7UL) << 8U) | (((uint32_t) (ref)) & 0xFFUL))
+#define EVE_DL_BEGIN(prim) ((DL_BEGIN) | (((uint32_t) (prim)) & 15UL))
+#define EVE_DL_BITMAP_HANDLE(handle) ((DL_BITMAP_HANDLE) | (((uint32_t) (handle)) & 0x1FUL))
+#define EVE_DL_BITMAP_LAYOUT(format, linestride, height) ((DL_BITMAP_LAYOUT) | ((((uint32_t) (format)) & 0x1FUL) << 19U) | ((((uint32_t) (linestride)) & 0x3FFUL) << 9U) | (((uint32_t) (height)) & 0x1FFUL))
+#define EVE_DL_BITMAP_LAYOUT_H(linestride, height) ((DL_BITMAP_LAYOUT_H) | (((((uint32_t) (linestride)) >> 10U) & 3UL) << 2U) | ((((uint32_t) (height)) >> 9U) & 3UL))
+#define EVE_DL_BITMAP_SIZE(filter, wrapx, wrapy, width, height) ((DL_BITMAP_SIZE) | ((((uint32_t) (filter)) & 1UL) << 20U) | ((((uint32_t) (wrapx)) & 1UL) << 19U) | ((((uint32_t) (wrapy)) & 1UL) << 18U) | ((((uint32_t) (width)) & 0x1FFUL) << 9U) | (((uint32_t) (height)) & 0x1FFUL))
+#define EVE_DL_BITMAP_SIZE_H(width, height) ((DL_BITMAP_SIZE_H) | (((((uint32_t) (width)) >> 9U) & 3UL) << 2U) | ((((uint32_t) (height)) >> 9U) & 3UL))
+#define EVE_DL_BITMAP_SOURCE(addr) ((DL_BITMAP_SOURCE) | (((uint32_t) (addr)) & 0xFFFFFFUL))
+#define EVE_DL_BLEND_FUNC(src, dst) ((DL_BLEND_FUNC) | ((((uint32_t) (src)) & 7UL) << 3U) | (((uint32_t) (dst)) & 7UL))
+#define EVE_DL_CALL(dest) ((DL_CALL) | (((uint32_t) (dest)) & 0xFFFFUL))
+#define EVE_DL_CELL(cell) ((DL_CELL) | (((uint32_t) (cell)) & 0x7FUL))
+#define EVE_DL_CLEAR(col, stn, tag) ((DL_CLEAR) | ((((uint32_t) (col)) & 1UL) << 2U) | ((((uint32_t) (stn)) & 1UL) << 1U) | (((uint32_t) (tag)) & 1UL))
+#define EVE_DL_CLEAR_COLOR_A(alpha) ((DL_CLEAR_COLOR_A) | (((uint32_t) (alpha)) & 0xFFUL))
+#define EVE_DL_CLEAR_COLOR_RGB(color) ((DL_CLEAR_COLOR_RGB) | (((uint32_t) (color)) & 0xFFFFFFUL))
+#define EVE_DL_CLEAR_STENCIL(stn) ((DL_CLEAR_STENCIL) | (((uint32_t) (stn)) & 0xFFUL))
+#define EVE_DL_CLEAR_TAG(tag) ((DL_CLEAR_TAG) | (((uint32_t) (tag)) & 0xFFUL))
+#define EVE_DL_COLOR_A(alpha) ((DL_COLOR_A) | (((uint32_t) (alpha)) & 0xFFUL))
+#define EVE_DL_COLOR_MASK(red, green, blue, alpha) ((DL_COLOR_MASK) | ((((uint32_t) (red)) & 1UL) << 3U) | ((((uint32_t) (green)) & 1UL) << 2U) | ((((uint32_t) (blue)) & 1UL) << 1U) | (((uint32_t) (alpha)) & 1UL))
+#define EVE_DL_COLOR_RGB(color) ((DL_COLOR_RGB) | (((uint32_t) (color)) & 0xFFFFFFUL))
+#define EVE_DL_JUMP(dest) ((DL_JUMP) | (((uint32_t) (dest)) & 0xFFFFUL))
+#define EVE_DL_LINE_WIDTH(width) ((DL_LINE_WIDTH) | (((uint32_t) (width)) & 0xFFFUL))
+#define EVE_DL_MACRO(macro) ((DL_MACRO) | (((uint32_t) (macro)) & 1UL))
+#define EVE_DL_PALETTE_SOURCE(addr) ((DL_PALETTE_SOURCE) | (((uint32_t) (addr)) & 0x3FFFFFUL))
+#define EVE_DL_POINT_SIZE(size) ((DL_POINT_SIZE) | (((uint32_t) (size)) & 0x1FFFUL))
+#define EVE_DL_SCISSOR_SIZE(width, height) ((DL_SCISSOR_SIZE) | ((((uint32_t) (width)) & 0xFFFUL) << 12U) | (((uint32_t) (height)) & 0xFFFUL))
+#define EVE_DL_SCISSOR_XY(xc0, yc0) ((DL_SCISSOR_XY) | ((((uint32_t) (xc0)) & 0x7FFUL) << 11U) | (((uint32_t) (yc0)) & 0x7FFUL))
+#define EVE_DL_STENCIL_FUNC(func, ref, mask) ((DL_STENCIL_FUNC) | ((((uint32_t) (func)) & 7UL) << 16U) | ((((uint32_t) (ref)) & 0xFFUL) << 8U) | (((uint32_t) (mask)) & 0xFFUL))
+#define EVE_DL_STENCIL_MASK(mask) ((DL_STENCIL_MASK) | (((uint32_t) (mask)) & 0xFFUL))
+#define EVE_DL_STENCIL_OP(sfail, spass) ((DL_STENCIL_OP) | ((((uint32_t) (sfail)) & 7UL) << 3U) | (((uint32_t) (spass)) & 7UL))
+#define EVE_DL_TAG(tag) ((DL_TAG) | (((uint32_t) (tag)) & 0xFFUL))
+#define EVE_DL_TAG_MASK(mask) ((DL_TAG_MASK) | (((uint32_t) (mask)) & 1UL))
+#define EVE_DL_VERTEX2F(xc0, yc0) ((DL_VERTEX2F) | ((((uint32_t) (xc0)) & 0x7FFFUL) << 15U) | (((uint32_t) (yc0)) & 0x7FFFUL))
+#define EVE_DL_VERTEX2II(xc0, yc0, handle, cell) ((DL_VERTEX2II) | ((((uint32_t) (xc0)) & 0x1FFUL) << 21U) | ((((uint32_t) (yc0)) & 0x1FFUL) << 12U) | ((((uint32_t) (handle)) & 0x1FUL) << 7U) | (((uint32_t) (cell)) & 0x7FUL))
+#define EVE_DL_VERTEX_FORMAT(frac) ((DL_VERTEX_FORMAT) | (((uint32_t) (frac)) & 7UL))
+#define EVE_DL_VERTEX_TRANSLATE_X(xc0) ((DL_VERTEX_TRANSLATE_X) | (((uint32_t) (xc0)) & 0x1FFFFUL))
+#define EVE_DL_VERTEX_TRANSLATE_Y(yc0) ((DL_VERTEX_TRANSLATE_Y) | (((uint32_t) (yc0)) & 0x1FFFFUL))
+
+#if EVE_GEN > 2
+#define EVE_DL_BITMAP_EXT_FORMAT(format) ((DL_BITMAP_EXT_FORMAT) | (((uint32_t) (format)) & 0xFFFFUL))
+#define EVE_DL_BITMAP_SWIZZLE(red, green, blue, alpha) ((DL_BITMAP_SWIZZLE) | ((((uint32_t) (red)) & 7UL) << 9U) | ((((uint32_t) (green)) & 7UL) << 6U) | ((((uint32_t) (blue)) & 7UL) << 3U) | (((uint32_t) (alpha)) & 7UL))
+#endif /* EVE_GEN > 2 */
+
+/* ##################################################################
+    coprocessor commands, these expand to a comma separated list of words
+##################################################################### */
+
+/* the parameter words as the command functions in EVE_commands.c assemble them */
+#define EVE_DL_I16_I16(arg1, arg2) ((((uint32_t) (arg1)) & 0xFFFFUL) | ((((uint32_t) (arg2)) & 0xFFFFUL) << 16U))
+
+/* four characters of a string, little endian, the last word of a string needs at least one zero */
+#define EVE_DL_CHARS(chr0, chr1, chr2, chr3) ((((uint32_t) (chr0)) & 0xFFUL) | ((((uint32_t) (chr1)) & 0xFFUL) << 8U) | \
+                                             ((((uint32_t) (chr2)) & 0xFFUL) << 16U) | ((((uint32_t) (chr3)) & 0xFFUL) << 24U))
+
+/* initializer for an EVE_text_handle from a const array of EVE_DL_CHARS() words, for use with EVE_cmd_text_packed() */
+#define EVE_TEXT_HANDLE(list) {(list), EVE_STATIC_LIST_SIZE(list), 1U}
+
+#define EVE_DL_CMD_APPEND(ptr, num) CMD_APPEND, ((uint32_t) (ptr)), ((uint32_t) (num))
+#define EVE_DL_CMD_BGCOLOR(color) CMD_BGCOLOR, ((uint32_t) (color))
+#define EVE_DL_CMD_FGCOLOR(color) CMD_FGCOLOR, ((uint32_t) (color))
+#define EVE_DL_CMD_GRADCOLOR(color) CMD_GRADCOLOR, ((uint32_t) (color))
+#define EVE_DL_CMD_GRADIENT(xc0, yc0, rgb0, xc1, yc1, rgb1) CMD_GRADIENT, EVE_DL_I16_I16((xc0), (yc0)), ((uint32_t) (rgb0)), \
+                                                        EVE_DL_I16_I16((xc1), (yc1)), ((uint32_t) (rgb1))
+#define EVE_DL_CMD_NUMBER(xc0, yc0, font, options, number) CMD_NUMBER, EVE_DL_I16_I16((xc0), (yc0)), EVE_DL_I16_I16((font), (options)), ((uint32_t) (number))
+#define EVE_DL_CMD_PROGRESS(xc0, yc0, wid, hgt, options, val, range) CMD_PROGRESS, EVE_DL_I16_I16((xc0), (yc0)), EVE_DL_I16_I16((wid), (hgt)), \
+                                                                 EVE_DL_I16_I16((options), (val)), EVE_DL_I16_I16((range), 0U)
+#define EVE_DL_CMD_ROMFONT(font, romslot) CMD_ROMFONT, ((uint32_t) (font)), ((uint32_t) (romslot))
+#define EVE_DL_CMD_SETBITMAP(addr, fmt, width, height) CMD_SETBITMAP, ((uint32_t) (addr)), EVE_DL_I16_I16((fmt), (width)), EVE_DL_I16_I16((height), 0U)
+#define EVE_DL_CMD_SETFONT2(font, ptr, firstchar) CMD_SETFONT2, ((uint32_t) (font)), ((uint32_t) (ptr)), ((uint32_t) (firstchar))
+#define EVE_DL_CMD_SLIDER(xc0, yc0, wid, hgt, options, val, range) CMD_SLIDER, EVE_DL_I16_I16((xc0), (yc0)), EVE_DL_I16_I16((wid), (hgt)), \
+                                                               EVE_DL_I16_I16((options), (val)), EVE_DL_I16_I16((range), 0U)
+
+/* these need to be followed by the string given with EVE_DL_CHARS() */
+#define EVE_DL_CMD_BUTTON(xc0, yc0, wid, hgt, font, options) CMD_BUTTON, EVE_DL_I16_I16((xc0), (yc0)), EVE_DL_I16_I16((wid), (hgt)), EVE_DL_I16_I16((font), (options))
+#define EVE_DL_CMD_KEYS(xc0, yc0, wid, hgt, font, options) CMD_KEYS, EVE_DL_I16_I16((xc0), (yc0)), EVE_DL_I16_I16((wid), (hgt)), EVE_DL_I16_I16((font), (options))
+#define EVE_DL_CMD_TEXT(xc0, yc0, font, options) CMD_TEXT, EVE_DL_I16_I16((xc0), (yc0)), EVE_DL_I16_I16((font), (options))
+#define EVE_DL_CMD_TOGGLE(xc0, yc0, wid, font, options, state) CMD_TOGGLE, EVE_DL_I16_I16((xc0), (yc0)), EVE_DL_I16_I16((wid), (font)), EVE_DL_I16_I16((options), (state))
+
+/* ##################################################################
+    C++ builder, strings are padded by the compiler
+##################################################################### */
+
+#if defined (__cplusplus) && (__cplusplus >= 201402L)
+
+/**
+ * @brief Fixed size list of command words that is meant to be filled in a constexpr function.
+ * @note - Running out of space is a compile time error when the list is built in constexpr context.
+ */
+template <uint16_t CAPACITY>
+class EVE_static_list
+{
+public:
+    uint32_t words[CAPACITY];
+    uint16_t num_words;
+
+    constexpr EVE_static_list() : words{}, num_words(0U)
+    {
+    }
+
+    constexpr EVE_static_list &dl(uint32_t command)
+    {
+        words[num_words] = command;
+        num_words++;
+        return (*this);
+    }
+
+    constexpr EVE_static_list &color_rgb(uint32_t color)
+    {
+        return (dl(EVE_DL_COLOR_RGB(color)));
+    }
+
+    constexpr EVE_static_list &vertex2f(int16_t xc0, int16_t yc0)
+    {
+        return (dl(EVE_DL_VERTEX2F((uint16_t) xc0, (uint16_t) yc0)));
+    }
+
+    constexpr EVE_static_list &bgcolor(uint32_t color)
+    {
+        return (dl(CMD_BGCOLOR).dl(color));
+    }
+
+    constexpr EVE_static_list &fgcolor(uint32_t color)
+    {
+        return (dl(CMD_FGCOLOR).dl(color));
+    }
+
+    constexpr EVE_static_list &setbitmap(uint32_t addr, uint16_t fmt, uint16_t width, uint16_t height)
+    {
+        return (dl(CMD_SETBITMAP).dl(addr).dl(EVE_DL_I16_I16(fmt, width)).dl(EVE_DL_I16_I16(height, 0U)));
+    }
+
+    constexpr EVE_static_list &button(int16_t xc0, int16_t yc0, uint16_t wid, uint16_t hgt,
+                                      uint16_t font, uint16_t options, const char *p_text)
+    {
+        dl(CMD_BUTTON).dl(EVE_DL_I16_I16((uint16_t) xc0, (uint16_t) yc0)).dl(EVE_DL_I16_I16(wid, hgt));
+        return (dl(EVE_DL_I16_I16(font, options)).string(p_text));
+    }
+
+    constexpr EVE_static_list &text(int16_t xc0, int16_t yc0, uint16_t font, uint16_t options, const char *p_text)
+    {
+        dl(CMD_TEXT).dl(EVE_DL_I16_I16((uint16_t) xc0, (uint16_t) yc0)).dl(EVE_DL_I16_I16(font, options));
+        return (string(p_text));
+    }
+
+    /* pack a zero terminated string into words, a string with a length of 4*n gets an extra zero word */
+    constexpr EVE_static_list &string(const char *p_text)
+    {
+        uint32_t word = 0U;
+        uint8_t shift = 0U;
+
+        for (uint16_t index = 0U; p_text[index] != '\0'; index++)
+        {
+            word |= ((uint32_t) ((uint8_t) p_text[index])) << shift;
+            shift += 8U;
+            if (32U == shift)
+            {
+                dl(word);
+                word = 0U;
+                shift = 0U;
+            }
+        }
+        return (dl(word));
+    }
+};
+
+#endif /* __cplusplus >= 201402L */
+
+#endif /* EVE_STATIC_DL_H */
@@ -60,9 +60,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - added STM32WB55xx to the STM32 target
 - reworked STM32 support, DMA is working for at least the F407, DMA for the H7 is still WIP
 - Bugfix: #136 thanks to Jwf68 on Github, EVE_PDN_PORT_NUM -> EVE_PD_PORT_NUM
+- added a Linux spidev target with an optional Unix socket connection to a simulator
+- added optional capture of all transfers to a file to the Linux target
+- added EVE_linux_receive_buffer() to the Linux target to read a block of memory in one transfer
+- EVE_linux_receive_buffer() releases chip-select with the last transfer, no extra transfer for EVE_cs_clear()
+- fix: the capture has all bytes read in a transfer, not only the last one
 
  */
 
+/* nanosleep() and the socket functions are not declared in strict C99 mode */
+#if defined (__linux__) && !defined (_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "EVE_target.h"
 
 #if !defined (ARDUINO)
@@ -1024,6 +1034,416 @@ void DMA0_Channel2_IRQHandler(void)
 #endif /* DMA */
 #endif /* GD32C103 */
 
+/* ################################################################## */
+/* ################################################################## */
+
+#if defined (__linux__)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#if defined (EVE_SIM_SOCKET)
+#include <sys/socket.h>
+#include <sys/un.h>
+#else
+#include <linux/spi/spidev.h>
+#endif
+
+#if defined (EVE_PDN) && !defined (EVE_SIM_SOCKET)
+#include <linux/gpio.h>
+#endif
+
+uint8_t EVE_linux_buffer[EVE_LINUX_BUFFER_SIZE];
+uint32_t EVE_linux_buffer_len = 0U;
+
+static uint8_t linux_rx_buffer[EVE_LINUX_BUFFER_SIZE];
+static int linux_fd = -1;
+static uint8_t linux_cs_active = 0U;
+static uint32_t linux_spi_speed = EVE_SPI_SPEED;
+
+#if defined (EVE_PDN) && !defined (EVE_SIM_SOCKET)
+static int linux_pdn_fd = -1;
+#endif
+
+void DELAY_MS(uint16_t val)
+{
+    struct timespec delay;
+
+    delay.tv_sec = (time_t) (val / 1000U);
+    delay.tv_nsec = ((long) (val % 1000U)) * 1000000L;
+
+    while ((nanosleep(&delay, &delay) != 0) && (EINTR == errno))
+    {
+    }
+}
+
+#if defined (EVE_CAPTURE)
+
+#include <stdio.h>
+
+static FILE *capture_file = NULL;
+static uint64_t capture_last_us = 0U;
+
+static uint64_t capture_time_us(void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((((uint64_t) now.tv_sec) * 1000000ULL) + (((uint64_t) now.tv_nsec) / 1000ULL));
+}
+
+static void capture_varint(uint32_t value)
+{
+    uint32_t rest = value;
+
+    do
+    {
+        uint8_t data = (uint8_t) (rest & 0x7FUL);
+
+        rest >>= 7U;
+        if (rest != 0U)
+        {
+            data |= 0x80U;
+        }
+        (void) fputc(data, capture_file);
+    } while (rest != 0U);
+}
+
+/* one record per transfer: time since the last record in us, flags, length and the MOSI bytes,
+   plus the number of bytes read and the MISO bytes of these if it was a read */
+static void capture_record(uint8_t flags, uint32_t len, const uint8_t *p_reply, uint32_t reply_len)
+{
+    if (capture_file != NULL)
+    {
+        uint64_t now = capture_time_us();
+        uint64_t delta = now - capture_last_us;
+
+        capture_last_us = now;
+        capture_varint((delta > 0xFFFFFFFFULL) ? 0xFFFFFFFFUL : (uint32_t) delta);
+        (void) fputc(flags, capture_file);
+        capture_varint(len);
+
+        if ((flags & EVE_CAPTURE_FLAG_PDN) == 0U)
+        {
+            (void) fwrite(EVE_linux_buffer, 1U, len, capture_file);
+            if (p_reply != NULL)
+            {
+                capture_varint(reply_len);
+                (void) fwrite(p_reply, 1U, reply_len, capture_file);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Start to record every transfer to a capture file, see tools/eve_replay.c.
+ */
+uint8_t EVE_linux_capture_start(const char *p_path)
+{
+    static const uint8_t header[8U] = {'E', 'V', 'E', 'C', 'A', 'P', EVE_CAPTURE_VERSION, 0U};
+    uint8_t ret = E_NOT_OK;
+
+    EVE_linux_capture_stop();
+    capture_file = fopen(p_path, "wb");
+    if (capture_file != NULL)
+    {
+        (void) fwrite(header, 1U, sizeof(header), capture_file);
+        capture_last_us = capture_time_us();
+        ret = E_OK;
+    }
+    return (ret);
+}
+
+void EVE_linux_capture_stop(void)
+{
+    if (capture_file != NULL)
+    {
+        (void) fclose(capture_file);
+        capture_file = NULL;
+    }
+}
+
+#else
+
+#define capture_record(flags, len, p_reply, reply_len)
+
+#endif /* EVE_CAPTURE */
+
+#if defined (EVE_SIM_SOCKET)
+
+/* frame header: type, flags, two reserved bytes, length as 32 bit little endian, followed by length bytes */
+#define SIM_FRAME_TRANSFER 0x54U /* 'T' */
+#define SIM_FRAME_PDN 0x50U /* 'P', flags is the level of the power-down line */
+#define SIM_FLAG_KEEP_CS 0x01U
+#define SIM_FLAG_REPLY 0x02U /* the simulator answers with length bytes of MISO data */
+
+static void sim_write(const uint8_t *p_data, uint32_t len)
+{
+    uint32_t offset = 0U;
+
+    while (offset < len)
+    {
+        ssize_t result = write(linux_fd, &p_data[offset], len - offset);
+
+        if (result <= 0)
+        {
+            if (EINTR != errno)
+            {
+                break;
+            }
+        }
+        else
+        {
+            offset += (uint32_t) result;
+        }
+    }
+}
+
+static void sim_read(uint8_t *p_data, uint32_t len)
+{
+    uint32_t offset = 0U;
+
+    while (offset < len)
+    {
+        ssize_t result = read(linux_fd, &p_data[offset], len - offset);
+
+        if (result <= 0)
+        {
+            if ((result < 0) && (EINTR == errno))
+            {
+                continue;
+            }
+            (void) memset(&p_data[offset], 0, len - offset);
+            break;
+        }
+        offset += (uint32_t) result;
+    }
+}
+
+static void sim_frame(uint8_t type, uint8_t flags, uint32_t len, uint8_t *p_reply)
+{
+    uint8_t header[8U];
+
+    header[0U] = type;
+    header[1U] = flags;
+    header[2U] = 0U;
+    header[3U] = 0U;
+    header[4U] = (uint8_t) (len & 0x000000ffUL);
+    header[5U] = (uint8_t) ((len >> 8U) & 0x000000ffUL);
+    header[6U] = (uint8_t) ((len >> 16U) & 0x000000ffUL);
+    header[7U] = (uint8_t) (len >> 24U);
+
+    sim_write(header, 8U);
+    sim_write(EVE_linux_buffer, len);
+
+    if (p_reply != NULL)
+    {
+        sim_read(p_reply, len);
+    }
+}
+
+static void linux_transfer(uint8_t *p_rx, uint32_t len, uint8_t keep_cs)
+{
+    uint8_t flags = (keep_cs != 0U) ? SIM_FLAG_KEEP_CS : 0U;
+
+    if (p_rx != NULL)
+    {
+        flags |= SIM_FLAG_REPLY;
+    }
+    sim_frame(SIM_FRAME_TRANSFER, flags, len, p_rx);
+}
+
+uint8_t EVE_init_spi(void)
+{
+    uint8_t ret = E_NOT_OK;
+    struct sockaddr_un address;
+
+    (void) memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    (void) strncpy(address.sun_path, EVE_SIM_SOCKET, sizeof(address.sun_path) - 1U);
+
+    linux_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (linux_fd >= 0)
+    {
+        if (0 == connect(linux_fd, (const struct sockaddr *) &address, sizeof(address)))
+        {
+            ret = E_OK;
+        }
+    }
+    return (ret);
+}
+
+void EVE_linux_set_pdn(uint8_t level)
+{
+    EVE_linux_flush(0U);
+    sim_frame(SIM_FRAME_PDN, level, 0U, NULL);
+    capture_record(EVE_CAPTURE_FLAG_PDN, level, NULL, 0U);
+}
+
+#else /* spidev */
+
+static void linux_transfer(uint8_t *p_rx, uint32_t len, uint8_t keep_cs)
+{
+    struct spi_ioc_transfer xfer;
+
+    (void) memset(&xfer, 0, sizeof(xfer));
+    xfer.tx_buf = (uint64_t) (uintptr_t) EVE_linux_buffer;
+    xfer.rx_buf = (uint64_t) (uintptr_t) p_rx;
+    xfer.len = len;
+    xfer.speed_hz = linux_spi_speed;
+    xfer.bits_per_word = 8U;
+    xfer.cs_change = keep_cs; /* on the last transfer of a message this keeps chip-select asserted */
+
+    (void) ioctl(linux_fd, SPI_IOC_MESSAGE(1), &xfer);
+}
+
+uint8_t EVE_init_spi(void)
+{
+    uint8_t ret = E_NOT_OK;
+    uint8_t mode = SPI_MODE_0;
+    uint8_t bits = 8U;
+
+    linux_fd = open(EVE_SPIDEV, O_RDWR);
+    if (linux_fd >= 0)
+    {
+        if ((ioctl(linux_fd, SPI_IOC_WR_MODE, &mode) >= 0) &&
+            (ioctl(linux_fd, SPI_IOC_WR_BITS_PER_WORD, &bits) >= 0) &&
+            (ioctl(linux_fd, SPI_IOC_WR_MAX_SPEED_HZ, &linux_spi_speed) >= 0))
+        {
+            ret = E_OK;
+        }
+    }
+
+#if defined (EVE_PDN)
+    if (E_OK == ret)
+    {
+        int chip_fd = open(EVE_GPIOCHIP, O_RDWR);
+        struct gpio_v2_line_request request;
+
+        ret = E_NOT_OK;
+        if (chip_fd >= 0)
+        {
+            (void) memset(&request, 0, sizeof(request));
+            request.offsets[0U] = EVE_PDN;
+            request.num_lines = 1U;
+            request.config.flags = GPIO_V2_LINE_FLAG_OUTPUT; /* power-down is active-low -> initialized to low */
+            (void) strncpy(request.consumer, "EVE_PDN", sizeof(request.consumer) - 1U);
+
+            if (ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &request) >= 0)
+            {
+                linux_pdn_fd = request.fd;
+                ret = E_OK;
+            }
+            (void) close(chip_fd);
+        }
+    }
+#endif
+
+    return (ret);
+}
+
+void EVE_linux_set_pdn(uint8_t level)
+{
+#if defined (EVE_PDN)
+    struct gpio_v2_line_values values;
+
+    values.bits = level;
+    values.mask = 1U;
+    (void) ioctl(linux_pdn_fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values);
+#else
+    (void) level;
+#endif
+    capture_record(EVE_CAPTURE_FLAG_PDN, level, NULL, 0U);
+}
+
+#endif /* EVE_SIM_SOCKET */
+
+/* the SPI clock is set per transfer, so this can be changed at any time, for example after EVE_init() */
+void EVE_linux_set_speed(uint32_t speed)
+{
+    linux_spi_speed = speed;
+}
+
+/* send the collected bytes, a transfer with length zero only releases chip-select */
+void EVE_linux_flush(uint8_t keep_cs)
+{
+    if ((EVE_linux_buffer_len > 0U) || ((0U == keep_cs) && (linux_cs_active != 0U)))
+    {
+        linux_transfer(NULL, EVE_linux_buffer_len, keep_cs);
+        capture_record(keep_cs, EVE_linux_buffer_len, NULL, 0U);
+        linux_cs_active = keep_cs;
+    }
+    EVE_linux_buffer_len = 0U;
+}
+
+void EVE_linux_cs_clear(void)
+{
+    EVE_linux_flush(0U);
+}
+
+uint8_t EVE_linux_transfer_byte(uint8_t data)
+{
+    uint32_t len;
+
+    if (EVE_linux_buffer_len >= EVE_LINUX_BUFFER_SIZE)
+    {
+        EVE_linux_flush(1U);
+    }
+
+    EVE_linux_buffer[EVE_linux_buffer_len] = data;
+    len = EVE_linux_buffer_len + 1U;
+
+    linux_transfer(linux_rx_buffer, len, 1U);
+    capture_record(EVE_CAPTURE_FLAG_KEEP_CS | EVE_CAPTURE_FLAG_REPLY, len, &linux_rx_buffer[len - 1U], 1U);
+    linux_cs_active = 1U;
+    EVE_linux_buffer_len = 0U;
+
+    return (linux_rx_buffer[len - 1U]);
+}
+
+/* send the collected bytes followed by len dummy bytes in one full-duplex transfer that also releases chip-select,
+   only reads that do not fit into EVE_LINUX_BUFFER_SIZE are split, with chip-select kept asserted in between */
+void EVE_linux_receive_buffer(uint8_t *p_data, uint32_t len)
+{
+    uint32_t offset = 0U;
+
+    while (offset < len)
+    {
+        uint32_t head;
+        uint32_t chunk;
+        uint8_t keep_cs;
+
+        if (EVE_linux_buffer_len >= EVE_LINUX_BUFFER_SIZE)
+        {
+            EVE_linux_flush(1U);
+        }
+
+        head = EVE_linux_buffer_len;
+        chunk = len - offset;
+        if (chunk > (EVE_LINUX_BUFFER_SIZE - head))
+        {
+            chunk = EVE_LINUX_BUFFER_SIZE - head;
+        }
+
+        keep_cs = ((offset + chunk) < len) ? 1U : 0U;
+
+        (void) memset(&EVE_linux_buffer[head], 0, chunk);
+        linux_transfer(linux_rx_buffer, head + chunk, keep_cs);
+        capture_record(((keep_cs != 0U) ? EVE_CAPTURE_FLAG_KEEP_CS : 0U) | EVE_CAPTURE_FLAG_REPLY, head + chunk,
+                       &linux_rx_buffer[head], chunk);
+        (void) memcpy(&p_data[offset], &linux_rx_buffer[head], chunk);
+        linux_cs_active = keep_cs;
+        EVE_linux_buffer_len = 0U;
+        offset += chunk;
+    }
+}
+
+#endif /* __linux__ */
+
 #endif /* __GNUC__ */
 
 /* ################################################################## */
@@ -93,6 +93,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 - added XMC4700_Relax_Kit
 - changed the Infineon XMC include to EVE_target_Arduino_Infineon_XMC.h
 - reworked STM32 support
+- added Linux spidev target
 
 */
 
@@ -296,6 +297,15 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 /* ################################################################## */
 /* ################################################################## */
 
+#if defined (__linux__)
+
+#include "EVE_target/EVE_target_Linux_spidev.h"
+
+#endif /* __linux__ */
+
+/* ################################################################## */
+/* ################################################################## */
+
 #endif /* __GNUC__ */
 
 /* ################################################################## */
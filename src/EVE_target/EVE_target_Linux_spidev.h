@@ -0,0 +1,196 @@
+/*
+@file    EVE_target_Linux_spidev.h
+@brief   target specific includes, definitions and functions
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+This is for Linux SoCs that have EVE connected to a SPI controller that is
+exposed thru spidev, the chip-select is driven by the SPI controller.
+All bytes sent while chip-select is active are collected in a buffer and are
+handed to the kernel as one SPI_IOC_MESSAGE when chip-select is released,
+so a burst of commands is a single ioctl() instead of one per byte.
+
+The optional power-down line is driven thru the GPIO character device.
+
+When EVE_SIM_SOCKET is defined the transfers are not sent to spidev but to a local
+process over a Unix domain socket, for example tools/eve_sim_socket.c.
+This allows to run and benchmark the complete stack on a build machine.
+
+When EVE_CAPTURE is defined EVE_linux_capture_start() records every transfer into a file
+that can be sent again with tools/eve_replay.c, the format is:
+- header: "EVECAP", version, one reserved byte
+- records: time since the previous record in us as varint, flags, length as varint, length MOSI bytes,
+  when EVE_CAPTURE_FLAG_REPLY is set followed by the number of bytes read as varint and the MISO bytes
+  of these, the reads are always the last bytes of the transfer
+- a record with EVE_CAPTURE_FLAG_PDN has no data and the level of the power-down line as length
+- varints are 7 bits per byte, least significant group first, bit 7 is set when another byte follows
+
+@section History
+
+5.0
+- initial version
+- added EVE_CAPTURE
+- added spi_receive_buffer() to read a block of memory with a single transfer
+- fix: EVE_CAPTURE_VERSION 2, a capture record has all bytes that were read, not only the last one
+
+*/
+
+#ifndef EVE_TARGET_LINUX_SPIDEV_H
+#define EVE_TARGET_LINUX_SPIDEV_H
+
+#if !defined (ARDUINO)
+#if defined (__GNUC__)
+
+#if defined (__linux__)
+
+#include <stdint.h>
+
+/* you may define these in your build-environment to use different settings */
+#if !defined (EVE_SPIDEV)
+#define EVE_SPIDEV "/dev/spidev0.0"
+#endif
+
+#if !defined (EVE_SPI_SPEED)
+#define EVE_SPI_SPEED 8000000UL /* no more than 11 MHz for the init, use EVE_linux_set_speed() afterwards */
+#endif
+
+#if !defined (EVE_GPIOCHIP)
+#define EVE_GPIOCHIP "/dev/gpiochip0"
+#endif
+
+/* line offset of the power-down pin on EVE_GPIOCHIP, the power-down line is not used when this is not defined */
+// #define EVE_PDN 25
+
+/* the default of the spidev "bufsiz" module parameter is 4096, this is the limit for one message */
+#if !defined (EVE_LINUX_BUFFER_SIZE)
+#define EVE_LINUX_BUFFER_SIZE 4096U
+#endif
+
+// #define EVE_SIM_SOCKET "/tmp/eve_sim.sock" /* to be defined in the build-environment */
+/* you may define these in your build-environment to use different settings */
+
+void DELAY_MS(uint16_t val);
+
+uint8_t EVE_init_spi(void);
+void EVE_linux_set_speed(uint32_t speed);
+void EVE_linux_flush(uint8_t keep_cs);
+void EVE_linux_cs_clear(void);
+void EVE_linux_set_pdn(uint8_t level);
+uint8_t EVE_linux_transfer_byte(uint8_t data);
+void EVE_linux_receive_buffer(uint8_t *p_data, uint32_t len);
+
+#if defined (EVE_CAPTURE)
+#define EVE_CAPTURE_VERSION 2U
+#define EVE_CAPTURE_FLAG_KEEP_CS 0x01U /* chip-select stays asserted after this transfer */
+#define EVE_CAPTURE_FLAG_REPLY 0x02U /* the last bytes of this transfer were a read */
+#define EVE_CAPTURE_FLAG_PDN 0x04U /* change of the power-down line */
+
+uint8_t EVE_linux_capture_start(const char *p_path);
+void EVE_linux_capture_stop(void);
+#endif
+
+extern uint8_t EVE_linux_buffer[EVE_LINUX_BUFFER_SIZE];
+extern uint32_t EVE_linux_buffer_len;
+
+static inline void EVE_cs_set(void)
+{
+    EVE_linux_buffer_len = 0U; /* chip-select is asserted with the first transfer */
+}
+
+static inline void EVE_cs_clear(void)
+{
+    EVE_linux_cs_clear();
+}
+
+static inline void EVE_pdn_set(void)
+{
+    EVE_linux_set_pdn(0U);
+}
+
+static inline void EVE_pdn_clear(void)
+{
+    EVE_linux_set_pdn(1U);
+}
+
+static inline void spi_transmit(uint8_t data)
+{
+    if (EVE_linux_buffer_len >= EVE_LINUX_BUFFER_SIZE)
+    {
+        EVE_linux_flush(1U);
+    }
+    EVE_linux_buffer[EVE_linux_buffer_len] = data;
+    EVE_linux_buffer_len++;
+}
+
+static inline void spi_transmit_32(uint32_t data)
+{
+    if ((EVE_linux_buffer_len + 4U) > EVE_LINUX_BUFFER_SIZE)
+    {
+        EVE_linux_flush(1U);
+    }
+    EVE_linux_buffer[EVE_linux_buffer_len] = (uint8_t) (data & 0x000000ffUL);
+    EVE_linux_buffer[EVE_linux_buffer_len + 1U] = (uint8_t) ((data >> 8U) & 0x000000ffUL);
+    EVE_linux_buffer[EVE_linux_buffer_len + 2U] = (uint8_t) ((data >> 16U) & 0x000000ffUL);
+    EVE_linux_buffer[EVE_linux_buffer_len + 3U] = (uint8_t) (data >> 24U);
+    EVE_linux_buffer_len += 4U;
+}
+
+/* spi_transmit_burst() is only used for cmd-FIFO commands */
+/* so it *always* has to transfer 4 bytes */
+static inline void spi_transmit_burst(uint32_t data)
+{
+    spi_transmit_32(data);
+}
+
+/* the bytes collected so far are sent together with the byte to be received */
+static inline uint8_t spi_receive(uint8_t data)
+{
+    return (EVE_linux_transfer_byte(data));
+}
+
+/* the bytes collected so far, usually address and dummy byte, are sent together with len bytes to be received, */
+/* chip-select is released with this transfer as EVE_cs_clear() follows */
+#define EVE_SPI_RECEIVE_BUFFER
+static inline void spi_receive_buffer(uint8_t *p_data, uint32_t len)
+{
+    EVE_linux_receive_buffer(p_data, len);
+}
+
+static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
+{
+    return (*p_data);
+}
+
+#endif /* __linux__ */
+
+#endif /* __GNUC__ */
+
+#endif /* !Arduino */
+
+#endif /* EVE_TARGET_LINUX_SPIDEV_H */
@@ -137,6 +137,15 @@ static inline uint8_t spi_receive(uint8_t data)
     /* return (byte received from SPI) */
 }
 
+/* optional: targets that can read a block in a single transfer define EVE_SPI_RECEIVE_BUFFER, */
+/* EVE_memRead8/16/32() and EVE_memRead_sram_buffer() then use spi_receive_buffer() instead of spi_receive() */
+/* for every byte, it is the last transfer before EVE_cs_clear() so chip-select may be released with it */
+// #define EVE_SPI_RECEIVE_BUFFER
+// static inline void spi_receive_buffer(uint8_t *p_data, uint32_t len)
+// {
+//     /* send len dummy bytes over SPI and store the bytes received in p_data */
+// }
+
 static inline uint8_t fetch_flash_byte(const uint8_t *p_data)
 {
     return (*p_data);
@@ -0,0 +1,402 @@
+/*
+@file    EVE_touch.c
+@brief   touch registers in one read, decoded into a snapshot and events per tag
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+Reading REG_TOUCH_TAG, REG_TOUCH_TAG1...4 and the coordinates of all five touches
+one register at a time takes up to fifteen SPI transfers as the registers are spread
+over the address range. EVE_touch_scan() reads the whole range from REG_CMD_DL
+to REG_CTOUCH_TOUCH3_XY with a single transfer and decodes it into a snapshot.
+The snapshot also has REG_CMD_DL and REG_TOUCH_CONFIG and REG_CTOUCH_EXTENDED from the
+same read are used to decide if there is more than one touch point.
+
+Every change of the touches is turned into events in a ring buffer:
+- EVE_TOUCH_EVENT_PRESS when a point is touched
+- EVE_TOUCH_EVENT_DRAG when it moved more than EVE_TOUCH_DRAG_DISTANCE from where it
+  was pressed and for every move after that, a drag that was not fetched yet is updated
+  instead of adding another one
+- EVE_TOUCH_EVENT_LONG_PRESS once when it is held longer than EVE_TOUCH_LONG_PRESS_MS without a drag
+- EVE_TOUCH_EVENT_RELEASE when it is no longer touched
+All events have the tag the touch started on, as EVE reports tag 0 for a released point.
+A point is only released after it is missing for EVE_TOUCH_RELEASE_READS reads in a row,
+so a single dropped read of a capacitive touch does not end a drag.
+When the ring buffer is full new events are dropped and counted.
+
+Instead of reading with every loop, EVE_touch_service() only reads after EVE_touch_irq()
+was called from the interrupt handler of the INT_N line, and then for as long as a point
+is touched for drags, the long press and the release. Without a touch there is no SPI
+traffic at all. The read starts at REG_INT_FLAGS, this clears the interrupt with the same transfer.
+A tap that starts and ends between two calls of EVE_touch_service() is not seen.
+
+EVE_touch_irq_enable();
+...
+void EXTI_IRQHandler(void) { EVE_touch_irq(); }
+...
+EVE_touch_service(systick_ms);
+
+The time is given by the application, for example a millisecond tick:
+
+EVE_touch_scan(systick_ms);
+while (E_OK == EVE_touch_get_event(&event))
+{
+    if ((EVE_TOUCH_EVENT_RELEASE == event.type) && (10U == event.tag)) ...
+}
+
+@section History
+
+5.0
+- initial version
+- added EVE_touch_service() for reads driven by the INT_N line
+
+*/
+
+#include "EVE_touch.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+#if (EVE_TOUCH_QUEUE_SIZE & (EVE_TOUCH_QUEUE_SIZE - 1U)) != 0U
+#error "EVE_TOUCH_QUEUE_SIZE needs to be a power of two"
+#endif
+
+typedef struct
+{
+    uint32_t press_time;
+    int16_t press_x;
+    int16_t press_y;
+    int16_t last_x;
+    int16_t last_y;
+    uint8_t tag;
+    uint8_t active;
+    uint8_t misses;    /* reads in a row without this point */
+    uint8_t dragging;
+    uint8_t long_sent;
+} touch_track;
+
+static EVE_touch_snapshot snapshot;
+static touch_track tracks[EVE_TOUCH_POINTS];
+static EVE_touch_event queue[EVE_TOUCH_QUEUE_SIZE];
+static uint8_t queue_head = 0U; /* next to write */
+static uint8_t queue_tail = 0U; /* next to read */
+static uint16_t queue_lost = 0U;
+static uint8_t window[EVE_TOUCH_IRQ_WINDOW_SIZE];
+static volatile uint8_t irq_pending = 0U;
+
+/* offsets of the registers in the window read from EVE_TOUCH_WINDOW_START */
+#define OFFSET(reg) ((uint32_t) ((reg) - EVE_TOUCH_WINDOW_START))
+
+static uint32_t get32(const uint8_t *p_window, uint32_t offset)
+{
+    return (((uint32_t) p_window[offset]) | (((uint32_t) p_window[offset + 1U]) << 8U) |
+            (((uint32_t) p_window[offset + 2U]) << 16U) | (((uint32_t) p_window[offset + 3U]) << 24U));
+}
+
+static void set_point(EVE_touch_snapshot *p_snapshot, uint8_t point, uint32_t xy, uint8_t tag)
+{
+    p_snapshot->points[point].xc0 = EVE_TOUCH_NO_TOUCH;
+    p_snapshot->points[point].yc0 = EVE_TOUCH_NO_TOUCH;
+    p_snapshot->points[point].tag = 0U;
+
+    if ((xy & 0x80008000UL) != 0x80008000UL)
+    {
+        p_snapshot->points[point].xc0 = (int16_t) (uint16_t) (xy >> 16U);
+        p_snapshot->points[point].yc0 = (int16_t) (uint16_t) xy;
+        p_snapshot->points[point].tag = tag;
+        p_snapshot->touched |= (uint8_t) (1U << point);
+        p_snapshot->count++;
+    }
+}
+
+/**
+ * @brief Decode a copy of the register window from EVE_TOUCH_WINDOW_START with EVE_TOUCH_WINDOW_SIZE bytes.
+ * @note Used by EVE_touch_scan(), available for data that was read otherwise.
+ */
+void EVE_touch_decode(const uint8_t *p_window, EVE_touch_snapshot *p_snapshot)
+{
+    if ((p_window != NULL) && (p_snapshot != NULL))
+    {
+        uint32_t touch4;
+        uint8_t multi;
+
+        p_snapshot->cmd_dl = (uint16_t) get32(p_window, OFFSET(REG_CMD_DL));
+        p_snapshot->touched = 0U;
+        p_snapshot->count = 0U;
+
+        /* capacitive touch in extended mode, otherwise the registers of touch 1...4 are something else */
+        multi = (uint8_t) ((0U == (get32(p_window, OFFSET(REG_TOUCH_CONFIG)) & 0x8000UL)) &&
+                           (0U == (get32(p_window, OFFSET(REG_CTOUCH_EXTENDED)) & 1UL)));
+
+        set_point(p_snapshot, 0U, get32(p_window, OFFSET(REG_CTOUCH_TOUCH0_XY)), p_window[OFFSET(REG_TOUCH_TAG)]);
+
+        if (multi != 0U)
+        {
+            touch4 = (get32(p_window, OFFSET(REG_CTOUCH_TOUCH4_X)) << 16U) | (get32(p_window, OFFSET(REG_CTOUCH_TOUCH4_Y)) & 0xFFFFUL);
+            set_point(p_snapshot, 1U, get32(p_window, OFFSET(REG_CTOUCH_TOUCH1_XY)), p_window[OFFSET(REG_TOUCH_TAG1)]);
+            set_point(p_snapshot, 2U, get32(p_window, OFFSET(REG_CTOUCH_TOUCH2_XY)), p_window[OFFSET(REG_TOUCH_TAG2)]);
+            set_point(p_snapshot, 3U, get32(p_window, OFFSET(REG_CTOUCH_TOUCH3_XY)), p_window[OFFSET(REG_TOUCH_TAG3)]);
+            set_point(p_snapshot, 4U, touch4, p_window[OFFSET(REG_TOUCH_TAG4)]);
+        }
+        else
+        {
+            for (uint8_t point = 1U; point < EVE_TOUCH_POINTS; point++)
+            {
+                set_point(p_snapshot, point, 0x80008000UL, 0U);
+            }
+        }
+    }
+}
+
+static void queue_event(uint8_t type, uint8_t point, int16_t xc0, int16_t yc0, uint32_t time_ms)
+{
+    uint8_t const previous = (uint8_t) ((queue_head - 1U) & (EVE_TOUCH_QUEUE_SIZE - 1U));
+    EVE_touch_event *p_event;
+
+    /* a drag that was not fetched yet is moved along */
+    if ((EVE_TOUCH_EVENT_DRAG == type) && (queue_head != queue_tail) &&
+        (EVE_TOUCH_EVENT_DRAG == queue[previous].type) && (point == queue[previous].point))
+    {
+        p_event = &queue[previous];
+    }
+    else if (((queue_head + 1U) & (EVE_TOUCH_QUEUE_SIZE - 1U)) == queue_tail)
+    {
+        queue_lost++;
+        return;
+    }
+    else
+    {
+        p_event = &queue[queue_head];
+        queue_head = (uint8_t) ((queue_head + 1U) & (EVE_TOUCH_QUEUE_SIZE - 1U));
+    }
+
+    p_event->time_ms = time_ms;
+    p_event->xc0 = xc0;
+    p_event->yc0 = yc0;
+    p_event->type = type;
+    p_event->tag = tracks[point].tag;
+    p_event->point = point;
+}
+
+static uint16_t distance(int16_t from, int16_t to)
+{
+    int32_t const delta = (int32_t) to - (int32_t) from;
+
+    return ((uint16_t) ((delta < 0) ? -delta : delta));
+}
+
+static void track_point(uint8_t point, uint32_t time_ms)
+{
+    const EVE_touch_point *p_point = &snapshot.points[point];
+    touch_track *p_track = &tracks[point];
+
+    if (0U == ((snapshot.touched >> point) & 1U))
+    {
+        if (p_track->active != 0U)
+        {
+            /* a point that is missing for a single read is not released yet */
+            p_track->misses++;
+            if (p_track->misses >= EVE_TOUCH_RELEASE_READS)
+            {
+                p_track->active = 0U;
+                queue_event(EVE_TOUCH_EVENT_RELEASE, point, p_track->last_x, p_track->last_y, time_ms);
+            }
+        }
+    }
+    else if (0U == p_track->active)
+    {
+        p_track->press_time = time_ms;
+        p_track->press_x = p_point->xc0;
+        p_track->press_y = p_point->yc0;
+        p_track->last_x = p_point->xc0;
+        p_track->last_y = p_point->yc0;
+        p_track->tag = p_point->tag;
+        p_track->active = 1U;
+        p_track->misses = 0U;
+        p_track->dragging = 0U;
+        p_track->long_sent = 0U;
+        queue_event(EVE_TOUCH_EVENT_PRESS, point, p_point->xc0, p_point->yc0, time_ms);
+    }
+    else
+    {
+        p_track->misses = 0U;
+
+        if ((0U == p_track->dragging) &&
+            ((distance(p_track->press_x, p_point->xc0) > EVE_TOUCH_DRAG_DISTANCE) ||
+             (distance(p_track->press_y, p_point->yc0) > EVE_TOUCH_DRAG_DISTANCE)))
+        {
+            p_track->dragging = 1U;
+        }
+
+        if ((p_track->dragging != 0U) &&
+            ((p_point->xc0 != p_track->last_x) || (p_point->yc0 != p_track->last_y)))
+        {
+            queue_event(EVE_TOUCH_EVENT_DRAG, point, p_point->xc0, p_point->yc0, time_ms);
+        }
+        else if ((0U == p_track->dragging) && (0U == p_track->long_sent) &&
+                 ((time_ms - p_track->press_time) >= EVE_TOUCH_LONG_PRESS_MS))
+        {
+            p_track->long_sent = 1U;
+            queue_event(EVE_TOUCH_EVENT_LONG_PRESS, point, p_point->xc0, p_point->yc0, time_ms);
+        }
+        else
+        {
+            /* nothing new */
+        }
+        p_track->last_x = p_point->xc0;
+        p_track->last_y = p_point->yc0;
+    }
+}
+
+static void track_points(const uint8_t *p_window, uint32_t time_ms)
+{
+    EVE_touch_decode(p_window, &snapshot);
+
+    for (uint8_t point = 0U; point < EVE_TOUCH_POINTS; point++)
+    {
+        track_point(point, time_ms);
+    }
+}
+
+static uint8_t any_active(void)
+{
+    uint8_t ret = 0U;
+
+    for (uint8_t point = 0U; point < EVE_TOUCH_POINTS; point++)
+    {
+        ret |= tracks[point].active;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Read all touch registers with a single transfer, update the snapshot and queue the events.
+ * @return E_OK, E_NOT_OK when a DMA transfer is still running
+ * @note Call this regularly, for example once per frame, the time is used for the long press.
+ */
+uint8_t EVE_touch_scan(uint32_t time_ms)
+{
+    uint8_t ret = E_NOT_OK;
+
+#if defined (EVE_DMA)
+    if (0 == EVE_dma_busy)
+    {
+#endif
+    EVE_memRead_sram_buffer(EVE_TOUCH_WINDOW_START, window, EVE_TOUCH_WINDOW_SIZE);
+    track_points(window, time_ms);
+    ret = E_OK;
+
+#if defined (EVE_DMA)
+    }
+#endif
+    return (ret);
+}
+
+/**
+ * @brief Enable the interrupts for touch and tag changes on the INT_N line for EVE_touch_service().
+ * @note The other bits in REG_INT_MASK are kept.
+ */
+void EVE_touch_irq_enable(void)
+{
+    uint8_t const mask = EVE_memRead8(REG_INT_MASK);
+
+    EVE_memWrite8(REG_INT_MASK, mask | EVE_INT_TOUCH | EVE_INT_TAG);
+    EVE_memWrite8(REG_INT_EN, 1U);
+    irq_pending = 1U; /* read once to clear REG_INT_FLAGS */
+}
+
+/**
+ * @brief Call this from the interrupt handler of the INT_N line, it only sets a flag.
+ */
+void EVE_touch_irq(void)
+{
+    irq_pending = 1U;
+}
+
+/**
+ * @brief Read the touch registers only after an interrupt and for as long as a point is touched.
+ * @return E_OK when the registers were read, E_NOT_OK when there was nothing to do or a DMA transfer is still running
+ * @note The read starts at REG_INT_FLAGS which clears the interrupt, the flags are in the snapshot
+ * for the other interrupt sources.
+ */
+uint8_t EVE_touch_service(uint32_t time_ms)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if ((irq_pending != 0U) || (any_active() != 0U))
+    {
+#if defined (EVE_DMA)
+        if (0 == EVE_dma_busy)
+        {
+#endif
+        irq_pending = 0U;
+        EVE_memRead_sram_buffer(EVE_TOUCH_IRQ_WINDOW_START, window, EVE_TOUCH_IRQ_WINDOW_SIZE);
+        snapshot.int_flags = window[0U];
+        track_points(&window[EVE_TOUCH_WINDOW_START - EVE_TOUCH_IRQ_WINDOW_START], time_ms);
+        ret = E_OK;
+#if defined (EVE_DMA)
+        }
+#endif
+    }
+    return (ret);
+}
+
+/**
+ * @brief The result of the last EVE_touch_scan() or EVE_touch_service().
+ */
+const EVE_touch_snapshot *EVE_touch_get_snapshot(void)
+{
+    return (&snapshot);
+}
+
+/**
+ * @brief Take the oldest event from the ring buffer.
+ * @return E_OK when an event was copied to p_event, E_NOT_OK when there is none
+ */
+uint8_t EVE_touch_get_event(EVE_touch_event *p_event)
+{
+    uint8_t ret = E_NOT_OK;
+
+    if ((p_event != NULL) && (queue_head != queue_tail))
+    {
+        *p_event = queue[queue_tail];
+        queue_tail = (uint8_t) ((queue_tail + 1U) & (EVE_TOUCH_QUEUE_SIZE - 1U));
+        ret = E_OK;
+    }
+    return (ret);
+}
+
+/**
+ * @brief Number of events that were dropped as the ring buffer was full.
+ */
+uint16_t EVE_touch_events_lost(void)
+{
+    return (queue_lost);
+}
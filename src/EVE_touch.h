@@ -0,0 +1,123 @@
+/*
+@file    EVE_touch.h
+@brief   touch registers in one read, decoded into a snapshot and events per tag
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+- added EVE_touch_service() for reads driven by the INT_N line
+
+*/
+
+#ifndef EVE_TOUCH_H
+#define EVE_TOUCH_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* you may define these in your build-environment to use different settings */
+#if !defined (EVE_TOUCH_QUEUE_SIZE)
+#define EVE_TOUCH_QUEUE_SIZE 16U /* events, a power of two */
+#endif
+
+#if !defined (EVE_TOUCH_LONG_PRESS_MS)
+#define EVE_TOUCH_LONG_PRESS_MS 500UL
+#endif
+
+#if !defined (EVE_TOUCH_DRAG_DISTANCE)
+#define EVE_TOUCH_DRAG_DISTANCE 8 /* pixels a touch has to move before it is a drag */
+#endif
+
+#if !defined (EVE_TOUCH_RELEASE_READS)
+#define EVE_TOUCH_RELEASE_READS 2U /* reads in a row without a point before it is released */
+#endif
+
+#define EVE_TOUCH_POINTS 5U
+
+/* the register window read with every scan, REG_CMD_DL to REG_CTOUCH_TOUCH3_XY */
+#define EVE_TOUCH_WINDOW_START REG_CMD_DL
+#define EVE_TOUCH_WINDOW_SIZE ((REG_CTOUCH_TOUCH3_XY + 4UL) - REG_CMD_DL)
+
+/* the register window read by EVE_touch_service(), from REG_INT_FLAGS to clear the interrupt as well */
+#define EVE_TOUCH_IRQ_WINDOW_START REG_INT_FLAGS
+#define EVE_TOUCH_IRQ_WINDOW_SIZE ((REG_CTOUCH_TOUCH3_XY + 4UL) - REG_INT_FLAGS)
+
+#define EVE_TOUCH_NO_TOUCH ((int16_t) -32768)
+
+#define EVE_TOUCH_EVENT_PRESS 1U
+#define EVE_TOUCH_EVENT_RELEASE 2U
+#define EVE_TOUCH_EVENT_DRAG 3U
+#define EVE_TOUCH_EVENT_LONG_PRESS 4U
+
+typedef struct
+{
+    int16_t xc0;   /* EVE_TOUCH_NO_TOUCH when not touched */
+    int16_t yc0;
+    uint8_t tag;
+} EVE_touch_point;
+
+typedef struct
+{
+    EVE_touch_point points[EVE_TOUCH_POINTS];
+    uint16_t cmd_dl;  /* REG_CMD_DL, the size of the last display list */
+    uint8_t int_flags; /* REG_INT_FLAGS, only read by EVE_touch_service() */
+    uint8_t touched;  /* one bit per point */
+    uint8_t count;    /* number of points touched */
+} EVE_touch_snapshot;
+
+typedef struct
+{
+    uint32_t time_ms;
+    int16_t xc0;
+    int16_t yc0;
+    uint8_t type;
+    uint8_t tag;      /* the tag the touch started on, also for drag and release */
+    uint8_t point;    /* 0...4 */
+} EVE_touch_event;
+
+uint8_t EVE_touch_scan(uint32_t time_ms);
+void EVE_touch_irq_enable(void);
+void EVE_touch_irq(void);
+uint8_t EVE_touch_service(uint32_t time_ms);
+void EVE_touch_decode(const uint8_t *p_window, EVE_touch_snapshot *p_snapshot);
+const EVE_touch_snapshot *EVE_touch_get_snapshot(void);
+uint8_t EVE_touch_get_event(EVE_touch_event *p_event);
+uint16_t EVE_touch_events_lost(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_TOUCH_H */
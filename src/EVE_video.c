@@ -0,0 +1,233 @@
+/*
+@file    EVE_video.c
+@brief   video playback as part of a normal display list, one frame at a time thru the media FIFO
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+EVE_cmd_playvideo() takes over the screen until the clip is done.
+Here the video is a bitmap in the display list like any other: EVE_video_update() keeps the
+media FIFO filled and decides when the next frame is due, EVE_video_draw() adds a CMD_VIDEOFRAME
+for it and the bitmap with the last complete frame to the display list that is built.
+Nothing waits for the coprocessor, a decoded frame is detected by the word at result_ptr
+that CMD_VIDEOFRAME overwrites.
+
+With two frame buffers the buffers are swapped once a frame is complete, the next frame is
+decoded into the retired buffer only after the display list that still shows it was replaced.
+So there is at most one new frame every second display frame, with buffer_b set to 0 it is
+decoded over the displayed frame and there is no such wait.
+When the display frames take longer than the video frames up to EVE_VIDEO_MAX_SKIP frames are
+decoded in one go and only the last one is shown, as long as the source did not end yet.
+
+EVE_mediafifo_init(MEM_FIFO, 32768UL);
+EVE_video_start(MEM_VIDEO_A, MEM_VIDEO_B, MEM_RESULT, 320U, 240U, 40U, read_from_sd, systick_ms);
+...
+(void) EVE_video_update(systick_ms);
+EVE_start_cmd_burst();
+EVE_cmd_dl_burst(CMD_DLSTART);
+...
+EVE_video_draw(100, 50);
+...
+
+The frames are RGB565, width * height * 2 bytes each, result_ptr needs 8 bytes in RAM_G.
+
+@section History
+
+5.0
+- initial version
+- fix: do not decode into the buffer the display list on screen still shows
+
+*/
+
+#include "EVE_video.h"
+
+/* define NULL if it not already is */
+#ifndef NULL
+#include <stdio.h>
+#endif
+
+#define VIDEO_PENDING 0xFFFFFFFFUL /* in result_ptr until CMD_VIDEOFRAME is done */
+
+static EVE_media_source video_source = NULL;
+static uint32_t video_front = 0UL; /* the buffer that is displayed */
+static uint32_t video_back = 0UL;  /* the buffer that is decoded into */
+static uint32_t video_result = 0UL;
+static uint32_t video_next = 0UL; /* time the next frame is due */
+static uint32_t video_dropped = 0UL;
+static uint16_t video_width = 0U;
+static uint16_t video_height = 0U;
+static uint16_t video_frame_ms = 0U;
+static uint8_t video_issue = 0U; /* frames to decode with the next EVE_video_draw() */
+static uint8_t video_pending = 0U;
+static uint8_t video_shown = 0U; /* video_front has a complete frame */
+static uint8_t video_last = 0U;
+static uint8_t video_done = 1U;
+
+/**
+ * @brief Start a video from the source, the media FIFO needs to be set up with EVE_mediafifo_init() before.
+ * @param buffer_b second frame buffer, 0 to decode over the displayed frame
+ * @param frame_ms time per video frame
+ * @note Meant to be called outside display-list building, this does not wait for the coprocessor.
+ */
+void EVE_video_start(uint32_t buffer_a, uint32_t buffer_b, uint32_t result_ptr, uint16_t width, uint16_t height,
+                     uint16_t frame_ms, EVE_media_source p_source, uint32_t time_ms)
+{
+    video_source = p_source;
+    video_front = buffer_a;
+    video_back = (0UL == buffer_b) ? buffer_a : buffer_b;
+    video_result = result_ptr;
+    video_width = width;
+    video_height = height;
+    video_frame_ms = (0U == frame_ms) ? 1U : frame_ms;
+    video_next = time_ms;
+    video_dropped = 0UL;
+    video_issue = 0U;
+    video_pending = 0U;
+    video_shown = 0U;
+    video_last = 0U;
+    video_done = 0U;
+
+    (void) EVE_mediafifo_fill(video_source, 0xFFFFFFFFUL);
+    EVE_cmd_dl(CMD_VIDEOSTART);
+}
+
+/**
+ * @brief Keep the media FIFO filled, check if the last frame is decoded and schedule the next one.
+ * @note Call this once per frame, before the display list is started.
+ * @note Does nothing while a DMA transfer is active.
+ * @return EVE_VIDEO_PLAYING, EVE_VIDEO_DONE after the last frame was decoded
+ */
+uint8_t EVE_video_update(uint32_t time_ms)
+{
+#if defined (EVE_DMA)
+    if (0 == EVE_dma_busy)
+    {
+#endif
+    if (0U == video_done)
+    {
+        uint8_t swapped = 0U;
+
+        (void) EVE_mediafifo_fill(video_source, 0xFFFFFFFFUL);
+
+        if (video_pending != 0U)
+        {
+            uint32_t const result = EVE_memRead32(video_result);
+
+            if (result != VIDEO_PENDING)
+            {
+                uint32_t const buffer = video_front;
+
+                video_front = video_back;
+                video_back = buffer;
+                video_pending = 0U;
+                video_shown = 1U;
+                swapped = (video_front != video_back) ? 1U : 0U;
+                if (0UL == result)
+                {
+                    video_last = 1U; /* that was the last frame of the video */
+                }
+            }
+        }
+
+        if ((0U == video_pending) && (0U == video_issue))
+        {
+            if (swapped != 0U)
+            {
+                /* the display list on screen still shows the retired buffer, decode into it with the next list */
+            }
+            else if (video_last != 0U)
+            {
+                video_done = 1U;
+            }
+            else if (((int32_t) (time_ms - video_next)) >= 0L)
+            {
+                uint32_t frames = ((time_ms - video_next) / video_frame_ms) + 1UL;
+
+                if (EVE_mediafifo_is_end() != 0U)
+                {
+                    frames = 1UL; /* only one frame is known to be there */
+                }
+
+                if (frames > (EVE_VIDEO_MAX_SKIP + 1UL))
+                {
+                    frames = EVE_VIDEO_MAX_SKIP + 1UL;
+                    video_next = time_ms; /* too far behind, start over from now */
+                }
+
+                video_next += frames * video_frame_ms;
+                video_dropped += frames - 1UL;
+                video_issue = (uint8_t) frames;
+                EVE_memWrite32(video_result, VIDEO_PENDING);
+            }
+            else
+            {
+                /* not due yet */
+            }
+        }
+    }
+#if defined (EVE_DMA)
+    }
+#endif
+    return (video_done);
+}
+
+/**
+ * @brief Add the CMD_VIDEOFRAME for the frames that are due and the bitmap with the last complete frame.
+ * @note Works with and without burst-mode, changes the parameters of EVE_VIDEO_HANDLE and the vertex format.
+ */
+void EVE_video_draw(int16_t xc0, int16_t yc0)
+{
+    if (video_shown != 0U)
+    {
+        EVE_cmd_dl(BITMAP_HANDLE(EVE_VIDEO_HANDLE));
+        EVE_cmd_setbitmap(video_front, EVE_RGB565, video_width, video_height);
+        EVE_cmd_dl(DL_VERTEX_FORMAT); /* set to 0 - pixel coordinates for VERTEX2F */
+        EVE_cmd_dl(DL_BEGIN | EVE_BITMAPS);
+        EVE_cmd_dl(VERTEX2F(xc0, yc0));
+        EVE_cmd_dl(DL_END);
+    }
+
+    /* after the bitmap, the coprocessor only writes to RAM_DL once the swap of the previous list is done */
+    while (video_issue != 0U)
+    {
+        video_issue--;
+        EVE_cmd_dl(CMD_VIDEOFRAME);
+        EVE_cmd_dl(video_back);
+        /* only the last one is waited for, the frames dropped before it write their result next to it */
+        EVE_cmd_dl((0U == video_issue) ? video_result : (video_result + 4UL));
+        video_pending = 1U;
+    }
+}
+
+/**
+ * @brief The number of frames that were decoded but not displayed as the display was too slow.
+ */
+uint32_t EVE_video_dropped(void)
+{
+    return (video_dropped);
+}
@@ -0,0 +1,72 @@
+/*
+@file    EVE_video.h
+@brief   video playback as part of a normal display list, one frame at a time thru the media FIFO
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#ifndef EVE_VIDEO_H
+#define EVE_VIDEO_H
+
+#include "EVE.h"
+#include "EVE_commands.h"
+#include "EVE_mediafifo.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* you may define these in your build-environment to use different settings */
+#if !defined (EVE_VIDEO_MAX_SKIP)
+#define EVE_VIDEO_MAX_SKIP 3U /* video frames that may be dropped per display frame to keep up */
+#endif
+
+#if !defined (EVE_VIDEO_HANDLE)
+#define EVE_VIDEO_HANDLE 0U /* bitmap handle for the frames */
+#endif
+
+#define EVE_VIDEO_PLAYING 0U
+#define EVE_VIDEO_DONE 1U
+
+void EVE_video_start(uint32_t buffer_a, uint32_t buffer_b, uint32_t result_ptr, uint16_t width, uint16_t height,
+                     uint16_t frame_ms, EVE_media_source p_source, uint32_t time_ms);
+uint8_t EVE_video_update(uint32_t time_ms);
+void EVE_video_draw(int16_t xc0, int16_t yc0);
+uint32_t EVE_video_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVE_VIDEO_H */
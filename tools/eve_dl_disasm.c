@@ -0,0 +1,1022 @@
+/*
+@file    eve_dl_disasm.c
+@brief   disassembler and statistics for coprocessor command streams and display lists
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+Turns the words of a coprocessor command stream or a display list back into the
+commands as they are written with the library, for example
+VERTEX2F(120,40) or CMD_TEXT(10,200,26,0,"DL-size:"), and reports per frame:
+- words and bytes per command, sorted by bytes, this is the SPI traffic a command costs
+- BEGIN and vertex counts per primitive
+- state changes and how many of these set a value that was already set
+- bytes of strings and bytes of data following commands like CMD_MEMWRITE or CMD_INFLATE
+
+The input is detected from the file:
+- a capture file recorded with EVE_CAPTURE by the Linux target, the coprocessor stream is
+  taken from the writes to REG_CMDB_WRITE and RAM_CMD and is split into frames at CMD_SWAP
+- a frame file written by tools/eve_sim_socket.c, the display list from RAM_DL
+- anything else is read as little endian words of a coprocessor stream,
+  or of a display list with -d, for example a dump of RAM_DL
+
+The opcodes are taken from src/EVE.h, a display with BT817 is selected for the build
+to get all of them, the options of CMD_INFLATE2, CMD_LOADIMAGE and CMD_PLAYVIDEO
+decide if data follows, the length of the data is found from its format.
+
+Build:
+gcc -std=c99 -Wall -Wextra -O2 -DEVE_RVT50H -I../src -o eve_dl_disasm eve_dl_disasm.c -lz
+
+Use:
+./eve_dl_disasm [-s] [-d] file
+-s: only the statistics, no listing
+-d: a raw file is a display list, not allowed for capture files
+
+@section History
+
+5.0
+- initial version
+- fix: reject -d for capture files, these only hold a coprocessor stream
+- fix: read version 2 capture files that have all bytes read in a transfer
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+#include "EVE.h"
+
+#define SLOT_VERTEX2F 0x40U
+#define SLOT_VERTEX2II 0x41U
+#define SLOT_CMD 0x42U
+#define SLOTS (SLOT_CMD + 0x80U)
+#define DL_OPCODES 0x30U
+
+typedef struct
+{
+    uint64_t count[SLOTS];
+    uint64_t bytes[SLOTS];
+    uint64_t begins[16U];
+    uint64_t vertices[16U];
+    uint64_t state_changes;
+    uint64_t repeated;
+    uint64_t string_bytes;
+    uint64_t data_bytes;
+    uint64_t words;
+    uint64_t total_bytes;
+} stats_t;
+
+typedef struct
+{
+    uint32_t cmd;
+    const char *p_name;
+    const char *p_args; /* h: int16, H: uint16, i: int32, u: uint32, w: uint32 hex, x: color, f: 16.16,
+                           s: string, D: length and data, Z: zlib data, I: image data, V: video data */
+} command_t;
+
+static const char *dl_names[DL_OPCODES] =
+{
+    [DL_DISPLAY >> 24U] = "DISPLAY", [DL_BITMAP_SOURCE >> 24U] = "BITMAP_SOURCE",
+    [DL_CLEAR_COLOR_RGB >> 24U] = "CLEAR_COLOR_RGB", [DL_TAG >> 24U] = "TAG", [DL_COLOR_RGB >> 24U] = "COLOR_RGB",
+    [DL_BITMAP_HANDLE >> 24U] = "BITMAP_HANDLE", [DL_CELL >> 24U] = "CELL",
+    [DL_BITMAP_LAYOUT >> 24U] = "BITMAP_LAYOUT", [DL_BITMAP_SIZE >> 24U] = "BITMAP_SIZE",
+    [DL_ALPHA_FUNC >> 24U] = "ALPHA_FUNC", [DL_STENCIL_FUNC >> 24U] = "STENCIL_FUNC",
+    [DL_BLEND_FUNC >> 24U] = "BLEND_FUNC", [DL_STENCIL_OP >> 24U] = "STENCIL_OP",
+    [DL_POINT_SIZE >> 24U] = "POINT_SIZE", [DL_LINE_WIDTH >> 24U] = "LINE_WIDTH",
+    [DL_CLEAR_COLOR_A >> 24U] = "CLEAR_COLOR_A", [DL_COLOR_A >> 24U] = "COLOR_A",
+    [DL_CLEAR_STENCIL >> 24U] = "CLEAR_STENCIL", [DL_CLEAR_TAG >> 24U] = "CLEAR_TAG",
+    [DL_STENCIL_MASK >> 24U] = "STENCIL_MASK", [DL_TAG_MASK >> 24U] = "TAG_MASK",
+    [DL_BITMAP_TRANSFORM_A >> 24U] = "BITMAP_TRANSFORM_A", [DL_BITMAP_TRANSFORM_B >> 24U] = "BITMAP_TRANSFORM_B",
+    [DL_BITMAP_TRANSFORM_C >> 24U] = "BITMAP_TRANSFORM_C", [DL_BITMAP_TRANSFORM_D >> 24U] = "BITMAP_TRANSFORM_D",
+    [DL_BITMAP_TRANSFORM_E >> 24U] = "BITMAP_TRANSFORM_E", [DL_BITMAP_TRANSFORM_F >> 24U] = "BITMAP_TRANSFORM_F",
+    [DL_SCISSOR_XY >> 24U] = "SCISSOR_XY", [DL_SCISSOR_SIZE >> 24U] = "SCISSOR_SIZE", [DL_CALL >> 24U] = "CALL",
+    [DL_JUMP >> 24U] = "JUMP", [DL_BEGIN >> 24U] = "BEGIN", [DL_COLOR_MASK >> 24U] = "COLOR_MASK",
+    [DL_END >> 24U] = "END", [DL_SAVE_CONTEXT >> 24U] = "SAVE_CONTEXT",
+    [DL_RESTORE_CONTEXT >> 24U] = "RESTORE_CONTEXT", [DL_RETURN >> 24U] = "RETURN", [DL_MACRO >> 24U] = "MACRO",
+    [DL_CLEAR >> 24U] = "CLEAR", [DL_VERTEX_FORMAT >> 24U] = "VERTEX_FORMAT",
+    [DL_BITMAP_LAYOUT_H >> 24U] = "BITMAP_LAYOUT_H", [DL_BITMAP_SIZE_H >> 24U] = "BITMAP_SIZE_H",
+    [DL_PALETTE_SOURCE >> 24U] = "PALETTE_SOURCE", [DL_VERTEX_TRANSLATE_X >> 24U] = "VERTEX_TRANSLATE_X",
+    [DL_VERTEX_TRANSLATE_Y >> 24U] = "VERTEX_TRANSLATE_Y", [DL_NOP >> 24U] = "NOP",
+    [DL_BITMAP_EXT_FORMAT >> 24U] = "BITMAP_EXT_FORMAT", [DL_BITMAP_SWIZZLE >> 24U] = "BITMAP_SWIZZLE"
+};
+
+static const char *prim_names[16U] =
+{
+    [EVE_BITMAPS] = "EVE_BITMAPS", [EVE_POINTS] = "EVE_POINTS", [EVE_LINES] = "EVE_LINES",
+    [EVE_LINE_STRIP] = "EVE_LINE_STRIP", [EVE_EDGE_STRIP_R] = "EVE_EDGE_STRIP_R",
+    [EVE_EDGE_STRIP_L] = "EVE_EDGE_STRIP_L", [EVE_EDGE_STRIP_A] = "EVE_EDGE_STRIP_A",
+    [EVE_EDGE_STRIP_B] = "EVE_EDGE_STRIP_B", [EVE_RECTS] = "EVE_RECTS"
+};
+
+static const command_t commands[] =
+{
+    {CMD_DLSTART, "CMD_DLSTART", ""}, {CMD_SWAP, "CMD_SWAP", ""}, {CMD_INTERRUPT, "CMD_INTERRUPT", "u"},
+    {CMD_BGCOLOR, "CMD_BGCOLOR", "x"}, {CMD_FGCOLOR, "CMD_FGCOLOR", "x"},
+    {CMD_GRADIENT, "CMD_GRADIENT", "hhxhhx"}, {CMD_TEXT, "CMD_TEXT", "hhhHs"},
+    {CMD_BUTTON, "CMD_BUTTON", "hhhhhHs"}, {CMD_KEYS, "CMD_KEYS", "hhhhhHs"},
+    {CMD_PROGRESS, "CMD_PROGRESS", "hhhhHHH"}, {CMD_SLIDER, "CMD_SLIDER", "hhhhHHH"},
+    {CMD_SCROLLBAR, "CMD_SCROLLBAR", "hhhhHHHH"}, {CMD_TOGGLE, "CMD_TOGGLE", "hhhhHHs"},
+    {CMD_GAUGE, "CMD_GAUGE", "hhhHHHHH"}, {CMD_CLOCK, "CMD_CLOCK", "hhhHHHHH"},
+    {CMD_CALIBRATE, "CMD_CALIBRATE", "u"}, {CMD_SPINNER, "CMD_SPINNER", "hhHH"}, {CMD_STOP, "CMD_STOP", ""},
+    {CMD_MEMCRC, "CMD_MEMCRC", "wuw"}, {CMD_REGREAD, "CMD_REGREAD", "ww"}, {CMD_MEMWRITE, "CMD_MEMWRITE", "wD"},
+    {CMD_MEMSET, "CMD_MEMSET", "wwu"}, {CMD_MEMZERO, "CMD_MEMZERO", "wu"}, {CMD_MEMCPY, "CMD_MEMCPY", "wwu"},
+    {CMD_APPEND, "CMD_APPEND", "wu"}, {CMD_SNAPSHOT, "CMD_SNAPSHOT", "w"},
+    {CMD_BITMAP_TRANSFORM, "CMD_BITMAP_TRANSFORM", "iiiiiiiiiiiiu"}, {CMD_INFLATE, "CMD_INFLATE", "wZ"},
+    {CMD_GETPTR, "CMD_GETPTR", "w"}, {CMD_LOADIMAGE, "CMD_LOADIMAGE", "wwI"},
+    {CMD_GETPROPS, "CMD_GETPROPS", "www"}, {CMD_LOADIDENTITY, "CMD_LOADIDENTITY", ""},
+    {CMD_TRANSLATE, "CMD_TRANSLATE", "ff"}, {CMD_SCALE, "CMD_SCALE", "ff"}, {CMD_ROTATE, "CMD_ROTATE", "u"},
+    {CMD_SETMATRIX, "CMD_SETMATRIX", ""}, {CMD_SETFONT, "CMD_SETFONT", "uw"}, {CMD_TRACK, "CMD_TRACK", "hhhhh"},
+    {CMD_DIAL, "CMD_DIAL", "hhhHH"}, {CMD_NUMBER, "CMD_NUMBER", "hhhHi"},
+    {CMD_SCREENSAVER, "CMD_SCREENSAVER", ""}, {CMD_SKETCH, "CMD_SKETCH", "hhHHwH"}, {CMD_LOGO, "CMD_LOGO", ""},
+    {CMD_COLDSTART, "CMD_COLDSTART", ""}, {CMD_GETMATRIX, "CMD_GETMATRIX", "iiiiii"},
+    {CMD_GRADCOLOR, "CMD_GRADCOLOR", "x"}, {CMD_SETROTATE, "CMD_SETROTATE", "u"},
+    {CMD_SNAPSHOT2, "CMD_SNAPSHOT2", "uwhhhh"}, {CMD_SETBASE, "CMD_SETBASE", "u"},
+    {CMD_MEDIAFIFO, "CMD_MEDIAFIFO", "wu"}, {CMD_PLAYVIDEO, "CMD_PLAYVIDEO", "wV"},
+    {CMD_SETFONT2, "CMD_SETFONT2", "uwu"}, {CMD_SETSCRATCH, "CMD_SETSCRATCH", "u"},
+    {CMD_ROMFONT, "CMD_ROMFONT", "uu"}, {CMD_VIDEOSTART, "CMD_VIDEOSTART", ""},
+    {CMD_VIDEOFRAME, "CMD_VIDEOFRAME", "ww"}, {CMD_SYNC, "CMD_SYNC", ""}, {CMD_SETBITMAP, "CMD_SETBITMAP", "wHHH"},
+    {CMD_FLASHERASE, "CMD_FLASHERASE", ""}, {CMD_FLASHWRITE, "CMD_FLASHWRITE", "wD"},
+    {CMD_FLASHREAD, "CMD_FLASHREAD", "wwu"}, {CMD_FLASHUPDATE, "CMD_FLASHUPDATE", "wwu"},
+    {CMD_FLASHDETACH, "CMD_FLASHDETACH", ""}, {CMD_FLASHATTACH, "CMD_FLASHATTACH", ""},
+    {CMD_FLASHFAST, "CMD_FLASHFAST", "w"}, {CMD_FLASHSPIDESEL, "CMD_FLASHSPIDESEL", ""},
+    {CMD_FLASHSPITX, "CMD_FLASHSPITX", "D"}, {CMD_FLASHSPIRX, "CMD_FLASHSPIRX", "wu"},
+    {CMD_FLASHSOURCE, "CMD_FLASHSOURCE", "w"}, {CMD_CLEARCACHE, "CMD_CLEARCACHE", ""},
+    {CMD_INFLATE2, "CMD_INFLATE2", "wwZ"}, {CMD_ROTATEAROUND, "CMD_ROTATEAROUND", "iiuf"},
+    {CMD_RESETFONTS, "CMD_RESETFONTS", ""}, {CMD_ANIMSTART, "CMD_ANIMSTART", "iwu"},
+    {CMD_ANIMSTOP, "CMD_ANIMSTOP", "i"}, {CMD_ANIMXY, "CMD_ANIMXY", "ihh"}, {CMD_ANIMDRAW, "CMD_ANIMDRAW", "i"},
+    {CMD_GRADIENTA, "CMD_GRADIENTA", "hhwhhw"}, {CMD_FILLWIDTH, "CMD_FILLWIDTH", "u"},
+    {CMD_APPENDF, "CMD_APPENDF", "wu"}, {CMD_ANIMFRAME, "CMD_ANIMFRAME", "hhwu"},
+    {CMD_VIDEOSTARTF, "CMD_VIDEOSTARTF", ""}, {CMD_LINETIME, "CMD_LINETIME", "w"},
+    {CMD_CALIBRATESUB, "CMD_CALIBRATESUB", "HHHHu"}, {CMD_TESTCARD, "CMD_TESTCARD", ""},
+    {CMD_HSF, "CMD_HSF", "u"}, {CMD_APILEVEL, "CMD_APILEVEL", "u"}, {CMD_GETIMAGE, "CMD_GETIMAGE", "wwwww"},
+    {CMD_WAIT, "CMD_WAIT", "u"}, {CMD_RETURN, "CMD_RETURN", ""}, {CMD_CALLLIST, "CMD_CALLLIST", "w"},
+    {CMD_NEWLIST, "CMD_NEWLIST", "w"}, {CMD_ENDLIST, "CMD_ENDLIST", ""}, {CMD_PCLKFREQ, "CMD_PCLKFREQ", "uiu"},
+    {CMD_FONTCACHE, "CMD_FONTCACHE", "uwu"}, {CMD_FONTCACHEQUERY, "CMD_FONTCACHEQUERY", "ww"},
+    {CMD_ANIMFRAMERAM, "CMD_ANIMFRAMERAM", "hhwu"}, {CMD_ANIMSTARTRAM, "CMD_ANIMSTARTRAM", "iwu"},
+    {CMD_RUNANIM, "CMD_RUNANIM", "ww"}, {CMD_FLASHPROGRAM, "CMD_FLASHPROGRAM", "wwu"}
+};
+
+static const command_t *command_table[0x80U];
+static stats_t frame;
+static stats_t total;
+static uint32_t frames;
+static int listing = 1;
+
+/* last value of the global display list state, cleared by RESTORE_CONTEXT and by coprocessor commands */
+static uint32_t dl_state[DL_OPCODES];
+static uint64_t dl_state_valid;
+static uint32_t dl_prim;
+
+static uint32_t get32(const uint8_t *p_data)
+{
+    return ((uint32_t) p_data[0U]) | (((uint32_t) p_data[1U]) << 8U) | (((uint32_t) p_data[2U]) << 16U) |
+           (((uint32_t) p_data[3U]) << 24U);
+}
+
+static int32_t sign_extend(uint32_t value, uint32_t bits)
+{
+    uint32_t const sign = 1UL << (bits - 1U);
+
+    value &= (sign << 1U) - 1U;
+    return ((int32_t) (value ^ sign) - (int32_t) sign);
+}
+
+static void print_dl(uint32_t word)
+{
+    uint32_t const opcode = word >> 24U;
+
+    if ((word & 0xC0000000UL) == DL_VERTEX2F)
+    {
+        printf("VERTEX2F(%ld,%ld)", (long) sign_extend(word >> 15U, 15U), (long) sign_extend(word, 15U));
+        return;
+    }
+    if ((word & 0xC0000000UL) == DL_VERTEX2II)
+    {
+        printf("VERTEX2II(%lu,%lu,%lu,%lu)", (unsigned long) ((word >> 21U) & 0x1FFU),
+               (unsigned long) ((word >> 12U) & 0x1FFU), (unsigned long) ((word >> 7U) & 0x1FU),
+               (unsigned long) (word & 0x7FU));
+        return;
+    }
+    if ((opcode >= DL_OPCODES) || (NULL == dl_names[opcode]))
+    {
+        printf("0x%08lx", (unsigned long) word);
+        return;
+    }
+
+    printf("%s(", dl_names[opcode]);
+    switch (opcode << 24U)
+    {
+        case DL_DISPLAY:
+        case DL_END:
+        case DL_SAVE_CONTEXT:
+        case DL_RESTORE_CONTEXT:
+        case DL_RETURN:
+        case DL_NOP:
+            break;
+        case DL_CLEAR_COLOR_RGB:
+        case DL_COLOR_RGB:
+            printf("%lu,%lu,%lu", (unsigned long) ((word >> 16U) & 0xFFU), (unsigned long) ((word >> 8U) & 0xFFU),
+                   (unsigned long) (word & 0xFFU));
+            break;
+        case DL_BITMAP_SOURCE:
+        case DL_PALETTE_SOURCE:
+            printf("0x%06lx", (unsigned long) (word & 0xFFFFFFUL));
+            break;
+        case DL_BITMAP_LAYOUT:
+            printf("%lu,%lu,%lu", (unsigned long) ((word >> 19U) & 0x1FU), (unsigned long) ((word >> 9U) & 0x3FFU),
+                   (unsigned long) (word & 0x1FFU));
+            break;
+        case DL_BITMAP_SIZE:
+            printf("%lu,%lu,%lu,%lu,%lu", (unsigned long) ((word >> 20U) & 1U), (unsigned long) ((word >> 19U) & 1U),
+                   (unsigned long) ((word >> 18U) & 1U), (unsigned long) ((word >> 9U) & 0x1FFU),
+                   (unsigned long) (word & 0x1FFU));
+            break;
+        case DL_BITMAP_LAYOUT_H:
+        case DL_BITMAP_SIZE_H:
+            printf("%lu,%lu", (unsigned long) ((word >> 2U) & 3U), (unsigned long) (word & 3U));
+            break;
+        case DL_ALPHA_FUNC:
+            printf("%lu,%lu", (unsigned long) ((word >> 8U) & 7U), (unsigned long) (word & 0xFFU));
+            break;
+        case DL_STENCIL_FUNC:
+            printf("%lu,%lu,%lu", (unsigned long) ((word >> 16U) & 7U), (unsigned long) ((word >> 8U) & 0xFFU),
+                   (unsigned long) (word & 0xFFU));
+            break;
+        case DL_BLEND_FUNC:
+        case DL_STENCIL_OP:
+            printf("%lu,%lu", (unsigned long) ((word >> 3U) & 7U), (unsigned long) (word & 7U));
+            break;
+        case DL_COLOR_MASK:
+        case DL_CLEAR:
+            if (DL_COLOR_MASK == (opcode << 24U))
+            {
+                printf("%lu,", (unsigned long) ((word >> 3U) & 1U));
+            }
+            printf("%lu,%lu,%lu", (unsigned long) ((word >> 2U) & 1U), (unsigned long) ((word >> 1U) & 1U),
+                   (unsigned long) (word & 1U));
+            break;
+        case DL_SCISSOR_XY:
+            printf("%lu,%lu", (unsigned long) ((word >> 11U) & 0x7FFU), (unsigned long) (word & 0x7FFU));
+            break;
+        case DL_SCISSOR_SIZE:
+            printf("%lu,%lu", (unsigned long) ((word >> 12U) & 0xFFFU), (unsigned long) (word & 0xFFFU));
+            break;
+        case DL_BEGIN:
+            if (prim_names[word & 15U] != NULL)
+            {
+                printf("%s", prim_names[word & 15U]);
+            }
+            else
+            {
+                printf("%lu", (unsigned long) (word & 15U));
+            }
+            break;
+        case DL_BITMAP_TRANSFORM_A:
+        case DL_BITMAP_TRANSFORM_B:
+        case DL_BITMAP_TRANSFORM_D:
+        case DL_BITMAP_TRANSFORM_E:
+            printf("%lu,%ld", (unsigned long) ((word >> 17U) & 1U), (long) sign_extend(word, 17U));
+            break;
+        case DL_BITMAP_TRANSFORM_C:
+        case DL_BITMAP_TRANSFORM_F:
+            printf("%ld", (long) sign_extend(word, 24U));
+            break;
+        case DL_VERTEX_TRANSLATE_X:
+        case DL_VERTEX_TRANSLATE_Y:
+            printf("%ld", (long) sign_extend(word, 17U));
+            break;
+        case DL_BITMAP_SWIZZLE:
+            printf("%lu,%lu,%lu,%lu", (unsigned long) ((word >> 9U) & 7U), (unsigned long) ((word >> 6U) & 7U),
+                   (unsigned long) ((word >> 3U) & 7U), (unsigned long) (word & 7U));
+            break;
+        case DL_POINT_SIZE:
+            printf("%lu", (unsigned long) (word & 0x1FFFU));
+            break;
+        case DL_LINE_WIDTH:
+            printf("%lu", (unsigned long) (word & 0xFFFU));
+            break;
+        case DL_CALL:
+        case DL_JUMP:
+        case DL_BITMAP_EXT_FORMAT:
+            printf("%lu", (unsigned long) (word & 0xFFFFU));
+            break;
+        default: /* one byte */
+            printf("%lu", (unsigned long) (word & ((DL_MACRO == (opcode << 24U)) ? 1U :
+                                                  ((DL_VERTEX_FORMAT == (opcode << 24U)) ? 7U : 0xFFU))));
+            break;
+    }
+    printf(")");
+}
+
+static void count_dl(uint32_t word)
+{
+    uint32_t const opcode = word >> 24U;
+    uint32_t slot = opcode;
+
+    if ((word & 0xC0000000UL) != 0U)
+    {
+        slot = ((word & 0xC0000000UL) == DL_VERTEX2F) ? SLOT_VERTEX2F : SLOT_VERTEX2II;
+        frame.vertices[dl_prim]++;
+    }
+    else if (opcode >= DL_OPCODES)
+    {
+        slot = 0x3FU; /* not a command, counted as one anyways */
+    }
+    else
+    {
+        switch (opcode << 24U)
+        {
+            case DL_BEGIN:
+                dl_prim = word & 15U;
+                frame.begins[dl_prim]++;
+                break;
+            case DL_DISPLAY:
+            case DL_END:
+            case DL_CLEAR:
+            case DL_NOP:
+            case DL_CALL:
+            case DL_JUMP:
+            case DL_RETURN:
+            case DL_MACRO:
+            case DL_SAVE_CONTEXT:
+                break;
+            case DL_RESTORE_CONTEXT:
+                dl_state_valid = 0U;
+                break;
+            case DL_BITMAP_SOURCE:
+            case DL_BITMAP_LAYOUT:
+            case DL_BITMAP_SIZE:
+            case DL_BITMAP_LAYOUT_H:
+            case DL_BITMAP_SIZE_H:
+            case DL_BITMAP_EXT_FORMAT:
+            case DL_BITMAP_SWIZZLE:
+                frame.state_changes++; /* per bitmap handle, not checked for repeats */
+                break;
+            default:
+                frame.state_changes++;
+                if (((dl_state_valid & (1ULL << opcode)) != 0U) && (dl_state[opcode] == word))
+                {
+                    frame.repeated++;
+                }
+                dl_state[opcode] = word;
+                dl_state_valid |= 1ULL << opcode;
+                break;
+        }
+    }
+
+    frame.count[slot]++;
+    frame.bytes[slot] += 4U;
+    frame.words++;
+    frame.total_bytes += 4U;
+}
+
+static void report(const stats_t *p_stats, const char *p_title)
+{
+    uint8_t done[SLOTS] = {0U};
+
+    printf("%s: %llu words, %llu bytes, %llu state changes (%llu repeated), %llu string bytes, %llu data bytes\n",
+           p_title, (unsigned long long) p_stats->words, (unsigned long long) p_stats->total_bytes,
+           (unsigned long long) p_stats->state_changes, (unsigned long long) p_stats->repeated,
+           (unsigned long long) p_stats->string_bytes, (unsigned long long) p_stats->data_bytes);
+    printf("  %-22s %10s %10s\n", "command", "count", "bytes");
+
+    for (;;)
+    {
+        uint32_t best = SLOTS;
+        const char *p_name;
+
+        for (uint32_t slot = 0U; slot < SLOTS; slot++)
+        {
+            if ((0U == done[slot]) && (p_stats->count[slot] != 0U) &&
+                ((SLOTS == best) || (p_stats->bytes[slot] > p_stats->bytes[best])))
+            {
+                best = slot;
+            }
+        }
+        if (SLOTS == best)
+        {
+            break;
+        }
+        done[best] = 1U;
+
+        if (SLOT_VERTEX2F == best)
+        {
+            p_name = "VERTEX2F";
+        }
+        else if (SLOT_VERTEX2II == best)
+        {
+            p_name = "VERTEX2II";
+        }
+        else if (best >= SLOT_CMD)
+        {
+            p_name = (command_table[best - SLOT_CMD] != NULL) ? command_table[best - SLOT_CMD]->p_name : "unknown";
+        }
+        else
+        {
+            p_name = ((best < DL_OPCODES) && (dl_names[best] != NULL)) ? dl_names[best] : "unknown";
+        }
+        printf("  %-22s %10llu %10llu\n", p_name, (unsigned long long) p_stats->count[best],
+               (unsigned long long) p_stats->bytes[best]);
+    }
+
+    printf("  %-22s %10s %10s\n", "primitive", "begins", "vertices");
+    for (uint32_t prim = 0U; prim < 16U; prim++)
+    {
+        if ((p_stats->begins[prim] != 0U) || (p_stats->vertices[prim] != 0U))
+        {
+            printf("  %-22s %10llu %10llu\n", (prim_names[prim] != NULL) ? prim_names[prim] : "none",
+                   (unsigned long long) p_stats->begins[prim], (unsigned long long) p_stats->vertices[prim]);
+        }
+    }
+}
+
+static void frame_end(void)
+{
+    char title[32];
+
+    if (0U == frame.words)
+    {
+        return;
+    }
+
+    snprintf(title, sizeof(title), "frame %lu", (unsigned long) frames);
+    report(&frame, title);
+    printf("\n");
+
+    for (uint32_t slot = 0U; slot < SLOTS; slot++)
+    {
+        total.count[slot] += frame.count[slot];
+        total.bytes[slot] += frame.bytes[slot];
+    }
+    for (uint32_t prim = 0U; prim < 16U; prim++)
+    {
+        total.begins[prim] += frame.begins[prim];
+        total.vertices[prim] += frame.vertices[prim];
+    }
+    total.state_changes += frame.state_changes;
+    total.repeated += frame.repeated;
+    total.string_bytes += frame.string_bytes;
+    total.data_bytes += frame.data_bytes;
+    total.words += frame.words;
+    total.total_bytes += frame.total_bytes;
+    memset(&frame, 0, sizeof(frame));
+    frames++;
+}
+
+static void disassemble_dl(const uint8_t *p_data, uint32_t size)
+{
+    for (uint32_t offset = 0U; (offset + 4U) <= size; offset += 4U)
+    {
+        uint32_t const word = get32(&p_data[offset]);
+
+        count_dl(word);
+        if (listing != 0)
+        {
+            printf("%6lu: ", (unsigned long) (offset / 4U));
+            print_dl(word);
+            printf("\n");
+        }
+        if (DL_DISPLAY == word)
+        {
+            break;
+        }
+    }
+    frame_end();
+}
+
+/* length of a zlib stream, 0 if it does not end within the data */
+static uint32_t zlib_length(const uint8_t *p_data, uint32_t size)
+{
+    static uint8_t scratch[16384U];
+    z_stream stream;
+    uint32_t ret = 0U;
+    int status;
+
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit(&stream) != Z_OK)
+    {
+        return (0U);
+    }
+    stream.next_in = (Bytef *) (uintptr_t) p_data;
+    stream.avail_in = size;
+    do
+    {
+        stream.next_out = scratch;
+        stream.avail_out = sizeof(scratch);
+        status = inflate(&stream, Z_NO_FLUSH);
+    } while (Z_OK == status);
+    if (Z_STREAM_END == status)
+    {
+        ret = (uint32_t) stream.total_in;
+    }
+    inflateEnd(&stream);
+    return (ret);
+}
+
+/* length of a PNG, JPEG or AVI file, 0 if it is not one of these or does not end within the data */
+static uint32_t file_length(const uint8_t *p_data, uint32_t size)
+{
+    uint32_t ret = 0U;
+
+    if ((size > 8U) && (0 == memcmp(p_data, "\x89PNG", 4U)))
+    {
+        uint32_t offset = 8U;
+
+        while ((offset + 12U) <= size)
+        {
+            uint32_t const len = ((uint32_t) p_data[offset] << 24U) | ((uint32_t) p_data[offset + 1U] << 16U) |
+                                 ((uint32_t) p_data[offset + 2U] << 8U) | p_data[offset + 3U];
+
+            if (0 == memcmp(&p_data[offset + 4U], "IEND", 4U))
+            {
+                ret = offset + 12U;
+                break;
+            }
+            offset += len + 12U;
+        }
+    }
+    else if ((size > 4U) && (0xFFU == p_data[0U]) && (0xD8U == p_data[1U]))
+    {
+        for (uint32_t offset = 2U; (offset + 1U) < size; offset++)
+        {
+            if ((0xFFU == p_data[offset]) && (0xD9U == p_data[offset + 1U]))
+            {
+                ret = offset + 2U;
+                break;
+            }
+        }
+    }
+    else if ((size > 8U) && (0 == memcmp(p_data, "RIFF", 4U)))
+    {
+        ret = get32(&p_data[4U]) + 8U;
+        ret = (ret <= size) ? ret : 0U;
+    }
+    else
+    {
+        ret = 0U;
+    }
+    return (ret);
+}
+
+static void disassemble_cmd(const uint8_t *p_data, uint32_t size)
+{
+    uint32_t offset = 0U;
+
+    while ((offset + 4U) <= size)
+    {
+        uint32_t const start = offset;
+        uint32_t const word = get32(&p_data[offset]);
+        const command_t *p_command = command_table[word & 0x7FU];
+        uint32_t args[16U];
+        uint32_t arg_count = 0U;
+        uint32_t half = 0U; /* 1: the upper half of the current word is next */
+        int lost = 0;
+
+        offset += 4U;
+
+        if ((word >> 24U) != 0xFFU)
+        {
+            count_dl(word);
+            if (listing != 0)
+            {
+                printf("%6lu: ", (unsigned long) start);
+                print_dl(word);
+                printf("\n");
+            }
+            continue;
+        }
+
+        if (((word & 0xFFFFFF80UL) != 0xFFFFFF00UL) || (NULL == p_command) || (p_command->cmd != word))
+        {
+            p_command = NULL;
+            lost = 1;
+        }
+
+        if (listing != 0)
+        {
+            printf("%6lu: %s(", (unsigned long) start, (p_command != NULL) ? p_command->p_name : "unknown");
+        }
+
+        for (const char *p_arg = (p_command != NULL) ? p_command->p_args : ""; (*p_arg != '\0') && (0 == lost);
+             p_arg++)
+        {
+            char const type = *p_arg;
+            uint32_t value = 0U;
+            uint32_t data_len = 0U;
+
+            if ((('h' == type) || ('H' == type)) && (half != 0U))
+            {
+                value = get32(&p_data[offset - 4U]) >> 16U;
+                half = 0U;
+            }
+            else if ((offset + 4U) <= size)
+            {
+                if (('s' != type) && ('Z' != type) && ('I' != type) && ('V' != type))
+                {
+                    value = get32(&p_data[offset]);
+                    offset += 4U;
+                    half = (('h' == type) || ('H' == type)) ? 1U : 0U;
+                }
+                else
+                {
+                    half = 0U;
+                }
+            }
+            else
+            {
+                lost = 1;
+                break;
+            }
+
+            if ((listing != 0) && (arg_count > 0U) && ('Z' != type) && ('I' != type) && ('V' != type))
+            {
+                printf(",");
+            }
+
+            switch (type)
+            {
+                case 'h':
+                    if (listing != 0)
+                    {
+                        printf("%ld", (long) sign_extend(value, 16U));
+                    }
+                    break;
+                case 'H':
+                    value &= 0xFFFFU;
+                    if (listing != 0)
+                    {
+                        printf("%lu", (unsigned long) value);
+                    }
+                    break;
+                case 'i':
+                    if (listing != 0)
+                    {
+                        printf("%ld", (long) (int32_t) value);
+                    }
+                    break;
+                case 'u':
+                    if (listing != 0)
+                    {
+                        printf("%lu", (unsigned long) value);
+                    }
+                    break;
+                case 'x':
+                    if (listing != 0)
+                    {
+                        printf("0x%06lx", (unsigned long) value);
+                    }
+                    break;
+                case 'f':
+                    if (listing != 0)
+                    {
+                        printf("%g", (double) (int32_t) value / 65536.0);
+                    }
+                    break;
+                case 's':
+                {
+                    uint32_t len = 0U;
+
+                    while (((offset + len) < size) && (p_data[offset + len] != 0U))
+                    {
+                        len++;
+                    }
+                    if ((offset + len) >= size)
+                    {
+                        lost = 1;
+                        break;
+                    }
+                    if (listing != 0)
+                    {
+                        printf("\"%.*s\"", (int) len, (const char *) &p_data[offset]);
+                    }
+                    len = (len + 4U) & ~3UL;
+                    frame.string_bytes += len;
+                    offset += len;
+                    break;
+                }
+                case 'D':
+                    if (listing != 0)
+                    {
+                        printf("%lu", (unsigned long) value);
+                    }
+                    data_len = value;
+                    break;
+                case 'Z':
+                case 'I':
+                case 'V':
+                    /* data follows unless the options of CMD_INFLATE2, CMD_LOADIMAGE or CMD_PLAYVIDEO say it does not */
+                    if ((CMD_INFLATE == word) ||
+                        (0U == (args[arg_count - 1U] & (EVE_OPT_MEDIAFIFO | EVE_OPT_FLASH))))
+                    {
+                        data_len = ('Z' == type) ? zlib_length(&p_data[offset], size - offset) :
+                                                   file_length(&p_data[offset], size - offset);
+                        if (0U == data_len)
+                        {
+                            lost = 1;
+                        }
+                        else if (listing != 0)
+                        {
+                            printf(" + %lu bytes", (unsigned long) data_len);
+                        }
+                    }
+                    break;
+                default:
+                    if (listing != 0)
+                    {
+                        printf("0x%08lx", (unsigned long) value);
+                    }
+                    break;
+            }
+
+            if (data_len != 0U)
+            {
+                data_len = (data_len + 3U) & ~3UL;
+                frame.data_bytes += data_len;
+                offset += data_len;
+            }
+
+            if (arg_count < 16U)
+            {
+                args[arg_count++] = value;
+            }
+        }
+
+        if (listing != 0)
+        {
+            printf(")%s\n", (lost != 0) ? " - can not follow, skipped until CMD_DLSTART" : "");
+        }
+
+        if (offset > size)
+        {
+            offset = size;
+        }
+        frame.count[SLOT_CMD + (word & 0x7FU)]++;
+        frame.bytes[SLOT_CMD + (word & 0x7FU)] += offset - start;
+        frame.words += (offset - start) / 4U;
+        frame.total_bytes += offset - start;
+
+        if (lost != 0)
+        {
+            while (((offset + 4U) <= size) && (get32(&p_data[offset]) != CMD_DLSTART))
+            {
+                offset += 4U;
+                frame.words++;
+                frame.total_bytes += 4U;
+            }
+        }
+
+        if (CMD_DLSTART == word)
+        {
+            dl_state_valid = 0U;
+            dl_prim = 0U;
+        }
+        else
+        {
+            dl_state_valid = 0U; /* widgets and other commands change the display list state */
+        }
+
+        if (CMD_SWAP == word)
+        {
+            frame_end();
+        }
+    }
+    frame_end();
+}
+
+static int read_varint(FILE *p_file, uint32_t *p_value)
+{
+    uint32_t value = 0U;
+    uint8_t shift = 0U;
+    int data;
+
+    do
+    {
+        data = fgetc(p_file);
+        if ((EOF == data) || (shift > 28U))
+        {
+            return (-1);
+        }
+        value |= ((uint32_t) (data & 0x7F)) << shift;
+        shift += 7U;
+    } while ((data & 0x80) != 0);
+
+    *p_value = value;
+    return (0);
+}
+
+/* collects the bytes written to REG_CMDB_WRITE and to RAM_CMD from a capture file */
+static uint8_t *capture_commands(FILE *p_file, uint32_t *p_size)
+{
+    uint8_t *p_stream = NULL;
+    uint32_t size = 0U;
+    uint32_t capacity = 0U;
+    uint32_t window_count = 0U;
+    uint32_t window_address = 0U;
+    uint8_t data[65536U];
+
+    for (;;)
+    {
+        uint32_t delay;
+        uint32_t len;
+        int flags;
+
+        if ((read_varint(p_file, &delay) != 0) || (EOF == (flags = fgetc(p_file))) ||
+            (read_varint(p_file, &len) != 0))
+        {
+            break;
+        }
+        if ((((uint32_t) flags) & 0x04U) != 0U) /* power-down line */
+        {
+            continue;
+        }
+        if ((len > sizeof(data)) || (fread(data, 1U, len, p_file) != len))
+        {
+            break;
+        }
+        if ((((uint32_t) flags) & 0x02U) != 0U) /* the bytes read */
+        {
+            uint32_t reply_len;
+
+            if ((read_varint(p_file, &reply_len) != 0) || (fseek(p_file, (long) reply_len, SEEK_CUR) != 0))
+            {
+                break;
+            }
+        }
+
+        for (uint32_t index = 0U; index < len; index++)
+        {
+            if (window_count < 3U)
+            {
+                window_address = (window_address << 8U) | data[index];
+            }
+            else if (((window_address & 0xC00000UL) == 0x800000UL) &&
+                     (((window_address & 0x3FFFFFUL) == REG_CMDB_WRITE) ||
+                      (((window_address & 0x3FFFFFUL) >= EVE_RAM_CMD) &&
+                       ((window_address & 0x3FFFFFUL) < (EVE_RAM_CMD + 4096UL)))))
+            {
+                if (size == capacity)
+                {
+                    uint8_t *p_new;
+
+                    capacity = (0U == capacity) ? 65536U : (capacity * 2U);
+                    p_new = realloc(p_stream, capacity);
+                    if (NULL == p_new)
+                    {
+                        free(p_stream);
+                        return (NULL);
+                    }
+                    p_stream = p_new;
+                }
+                p_stream[size++] = data[index];
+            }
+            else
+            {
+                /* neither REG_CMDB_WRITE nor RAM_CMD */
+            }
+            window_count++;
+        }
+
+        if (0U == (((uint32_t) flags) & 0x01U)) /* chip select released */
+        {
+            window_count = 0U;
+            window_address = 0U;
+        }
+    }
+
+    *p_size = size;
+    return (p_stream);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *p_path = NULL;
+    int display_list = 0;
+    uint8_t *p_data = NULL;
+    uint32_t size = 0U;
+    uint8_t header[8U];
+    FILE *p_file;
+
+    for (int arg = 1; arg < argc; arg++)
+    {
+        if (0 == strcmp(argv[arg], "-s"))
+        {
+            listing = 0;
+        }
+        else if (0 == strcmp(argv[arg], "-d"))
+        {
+            display_list = 1;
+        }
+        else
+        {
+            p_path = argv[arg];
+        }
+    }
+
+    if (NULL == p_path)
+    {
+        fprintf(stderr, "usage: %s [-s] [-d] file\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    for (uint32_t index = 0U; index < (sizeof(commands) / sizeof(commands[0U])); index++)
+    {
+        command_table[commands[index].cmd & 0x7FU] = &commands[index];
+    }
+
+    p_file = fopen(p_path, "rb");
+    if ((NULL == p_file) || (fread(header, 1U, sizeof(header), p_file) != sizeof(header)))
+    {
+        fprintf(stderr, "%s: could not read\n", p_path);
+        return (EXIT_FAILURE);
+    }
+
+    if (0 == memcmp(header, "EVECAP", 6U))
+    {
+        if (display_list != 0)
+        {
+            fprintf(stderr, "%s: -d is only for raw files, not for captures\n", p_path);
+            fclose(p_file);
+            return (EXIT_FAILURE);
+        }
+        if (header[6U] != 2U)
+        {
+            fprintf(stderr, "%s: capture version %u is not supported\n", p_path, (unsigned int) header[6U]);
+            fclose(p_file);
+            return (EXIT_FAILURE);
+        }
+        p_data = capture_commands(p_file, &size);
+    }
+    else
+    {
+        long file_size;
+
+        if (0 == memcmp(header, "EVEFRAME", 8U))
+        {
+            display_list = 1;
+            fseek(p_file, 36L, SEEK_SET); /* frame header, followed by RAM_DL */
+            file_size = 8192L;
+        }
+        else
+        {
+            fseek(p_file, 0L, SEEK_END);
+            file_size = ftell(p_file);
+            fseek(p_file, 0L, SEEK_SET);
+        }
+        p_data = malloc((size_t) file_size + 1U);
+        if (p_data != NULL)
+        {
+            size = (uint32_t) fread(p_data, 1U, (size_t) file_size, p_file);
+        }
+    }
+    fclose(p_file);
+
+    if (NULL == p_data)
+    {
+        fprintf(stderr, "%s: nothing to disassemble\n", p_path);
+        return (EXIT_FAILURE);
+    }
+
+    if (display_list != 0)
+    {
+        disassemble_dl(p_data, size);
+    }
+    else
+    {
+        disassemble_cmd(p_data, size);
+    }
+
+    if (frames > 1U)
+    {
+        report(&total, "all frames");
+    }
+
+    free(p_data);
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,345 @@
+/*
+@file    eve_flash_pack.c
+@brief   build a flash image for BT81x with the blob, a sorted asset index and the assets
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+The image starts with the 4096 bytes blob, the index follows at 4096 and the assets
+follow the index, each one 64 byte aligned and padded to a multiple of 4 bytes as
+required by CMD_FLASHREAD. The format of the index is described in src/EVE_flash_fs.h,
+the assets are found by name at runtime with EVE_flash_fs_find() / EVE_flash_fs_load().
+
+Build:
+gcc -std=c99 -Wall -Wextra -O2 -o eve_flash_pack eve_flash_pack.c
+
+./eve_flash_pack -b unified.blob -o flash.bin name=file[:format[:width[:height[:ram_size]]]] ...
+
+format is either a number or one of the names below, it defaults to RAW,
+ram_size is the size in RAM_G after loading, it defaults to the size of the file.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOB_SIZE 4096UL
+#define FS_MAGIC 0x53465645UL /* "EVFS" */
+#define FS_HEADER_SIZE 16UL
+#define FS_ENTRY_SIZE 32UL
+#define FS_RAW 0xFFFFFFFFUL
+
+typedef struct
+{
+    const char *p_name;
+    const char *p_file;
+    uint32_t hash;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t crc;
+    uint32_t format;
+    uint32_t ram_size;
+    uint32_t width;
+    uint32_t height;
+    uint8_t *p_data;
+} asset_t;
+
+static const struct
+{
+    const char *p_name;
+    uint32_t format;
+} formats[] =
+{
+    {"RAW", FS_RAW}, {"ARGB1555", 0UL}, {"L1", 1UL}, {"L4", 2UL}, {"L8", 3UL}, {"RGB332", 4UL},
+    {"ARGB2", 5UL}, {"ARGB4", 6UL}, {"RGB565", 7UL}, {"PALETTED565", 14UL}, {"PALETTED4444", 15UL},
+    {"PALETTED8", 16UL}, {"L2", 17UL}, {"ASTC_4X4", 37808UL}, {"ASTC_5X4", 37809UL}, {"ASTC_5X5", 37810UL},
+    {"ASTC_6X5", 37811UL}, {"ASTC_6X6", 37812UL}, {"ASTC_8X5", 37813UL}, {"ASTC_8X6", 37814UL},
+    {"ASTC_8X8", 37815UL}, {"ASTC_10X5", 37816UL}, {"ASTC_10X6", 37817UL}, {"ASTC_10X8", 37818UL},
+    {"ASTC_10X10", 37819UL}, {"ASTC_12X10", 37820UL}, {"ASTC_12X12", 37821UL}
+};
+
+/* the same as EVE_flash_fs_hash() */
+static uint32_t fnv1a(const char *p_name)
+{
+    uint32_t hash = 0x811C9DC5UL;
+
+    for (const uint8_t *p_byte = (const uint8_t *) p_name; *p_byte != 0U; p_byte++)
+    {
+        hash ^= *p_byte;
+        hash *= 0x01000193UL;
+    }
+    return (hash);
+}
+
+/* CRC-32 as calculated by CMD_MEMCRC */
+static uint32_t crc32(const uint8_t *p_data, uint32_t len)
+{
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (uint32_t index = 0U; index < len; index++)
+    {
+        crc ^= p_data[index];
+        for (uint8_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = (crc >> 1U) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));
+        }
+    }
+    return (~crc);
+}
+
+static void put32(uint8_t *p_data, uint32_t value)
+{
+    p_data[0U] = (uint8_t) value;
+    p_data[1U] = (uint8_t) (value >> 8U);
+    p_data[2U] = (uint8_t) (value >> 16U);
+    p_data[3U] = (uint8_t) (value >> 24U);
+}
+
+static uint8_t *load_file(const char *p_path, uint32_t *p_size)
+{
+    FILE *p_file = fopen(p_path, "rb");
+    uint8_t *p_data = NULL;
+    long size;
+
+    if (p_file != NULL)
+    {
+        fseek(p_file, 0L, SEEK_END);
+        size = ftell(p_file);
+        fseek(p_file, 0L, SEEK_SET);
+        p_data = calloc(1U, (size_t) size + 4U); /* room for the padding to 4 bytes */
+        if ((p_data != NULL) && (fread(p_data, 1U, (size_t) size, p_file) != (size_t) size))
+        {
+            free(p_data);
+            p_data = NULL;
+        }
+        *p_size = (uint32_t) size;
+        fclose(p_file);
+    }
+    return (p_data);
+}
+
+static uint32_t parse_format(const char *p_text)
+{
+    char *p_end;
+    uint32_t value = (uint32_t) strtoul(p_text, &p_end, 0);
+
+    if ((p_end == p_text) || (*p_end != '\0'))
+    {
+        value = FS_RAW - 1UL; /* marks an unknown name */
+        for (size_t index = 0U; index < (sizeof(formats) / sizeof(formats[0U])); index++)
+        {
+            if (0 == strcmp(p_text, formats[index].p_name))
+            {
+                value = formats[index].format;
+            }
+        }
+    }
+    return (value);
+}
+
+static int compare_hash(const void *p_a, const void *p_b)
+{
+    const asset_t *p_asset_a = (const asset_t *) p_a;
+    const asset_t *p_asset_b = (const asset_t *) p_b;
+
+    return ((p_asset_a->hash > p_asset_b->hash) - (p_asset_a->hash < p_asset_b->hash));
+}
+
+int main(int argc, char *argv[])
+{
+    const char *p_blob = NULL;
+    const char *p_output = NULL;
+    asset_t *p_assets;
+    uint32_t count = 0U;
+    uint32_t position;
+    uint32_t image_size;
+    uint8_t *p_image;
+    FILE *p_file;
+
+    p_assets = calloc((size_t) argc, sizeof(asset_t));
+    if (NULL == p_assets)
+    {
+        return (EXIT_FAILURE);
+    }
+
+    for (int arg = 1; arg < argc; arg++)
+    {
+        if ((0 == strcmp(argv[arg], "-b")) && ((arg + 1) < argc))
+        {
+            arg++;
+            p_blob = argv[arg];
+        }
+        else if ((0 == strcmp(argv[arg], "-o")) && ((arg + 1) < argc))
+        {
+            arg++;
+            p_output = argv[arg];
+        }
+        else
+        {
+            asset_t *p_asset = &p_assets[count];
+            char *p_field;
+            char *p_equal = strchr(argv[arg], '=');
+
+            if (NULL == p_equal)
+            {
+                fprintf(stderr, "%s: expected name=file\n", argv[arg]);
+                return (EXIT_FAILURE);
+            }
+            *p_equal = '\0';
+            p_asset->p_name = argv[arg];
+            p_asset->p_file = strtok(p_equal + 1, ":");
+            p_asset->format = FS_RAW;
+
+            p_field = strtok(NULL, ":");
+            if (p_field != NULL)
+            {
+                p_asset->format = parse_format(p_field);
+                if ((FS_RAW - 1UL) == p_asset->format)
+                {
+                    fprintf(stderr, "%s: unknown format %s\n", p_asset->p_name, p_field);
+                    return (EXIT_FAILURE);
+                }
+                p_field = strtok(NULL, ":");
+            }
+            p_asset->width = (p_field != NULL) ? (uint32_t) strtoul(p_field, NULL, 0) : 0U;
+            p_field = (p_field != NULL) ? strtok(NULL, ":") : NULL;
+            p_asset->height = (p_field != NULL) ? (uint32_t) strtoul(p_field, NULL, 0) : 0U;
+            p_field = (p_field != NULL) ? strtok(NULL, ":") : NULL;
+            p_asset->ram_size = (p_field != NULL) ? (uint32_t) strtoul(p_field, NULL, 0) : 0U;
+
+            p_asset->p_data = load_file(p_asset->p_file, &p_asset->size);
+            if (NULL == p_asset->p_data)
+            {
+                fprintf(stderr, "%s: could not read %s\n", p_asset->p_name, p_asset->p_file);
+                return (EXIT_FAILURE);
+            }
+            if (0U == p_asset->ram_size)
+            {
+                p_asset->ram_size = p_asset->size;
+            }
+            p_asset->size = (p_asset->size + 3U) & ~3UL;
+            p_asset->hash = fnv1a(p_asset->p_name);
+            p_asset->crc = crc32(p_asset->p_data, p_asset->size);
+            count++;
+        }
+    }
+
+    if ((NULL == p_output) || (0U == count))
+    {
+        fprintf(stderr, "usage: %s [-b blob] -o image name=file[:format[:width[:height[:ram_size]]]] ...\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    qsort(p_assets, count, sizeof(asset_t), compare_hash);
+    for (uint32_t index = 1U; index < count; index++)
+    {
+        if (p_assets[index].hash == p_assets[index - 1U].hash)
+        {
+            fprintf(stderr, "%s and %s have the same hash, rename one of them\n", p_assets[index].p_name,
+                    p_assets[index - 1U].p_name);
+            return (EXIT_FAILURE);
+        }
+    }
+
+    position = BLOB_SIZE + FS_HEADER_SIZE + (count * FS_ENTRY_SIZE);
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        position = (position + 63U) & ~63UL;
+        p_assets[index].offset = position;
+        position += p_assets[index].size;
+    }
+    image_size = (position + 4095U) & ~4095UL; /* whole sectors */
+
+    p_image = malloc(image_size);
+    if (NULL == p_image)
+    {
+        return (EXIT_FAILURE);
+    }
+    memset(p_image, 0xFF, image_size); /* unused bytes stay erased */
+
+    if (p_blob != NULL)
+    {
+        uint32_t blob_size;
+        uint8_t *p_blob_data = load_file(p_blob, &blob_size);
+
+        if ((NULL == p_blob_data) || (blob_size != BLOB_SIZE))
+        {
+            fprintf(stderr, "%s: the blob needs to have 4096 bytes\n", p_blob);
+            return (EXIT_FAILURE);
+        }
+        memcpy(p_image, p_blob_data, BLOB_SIZE);
+        free(p_blob_data);
+    }
+    else
+    {
+        fprintf(stderr, "warning: no blob, the image will not work with CMD_FLASHFAST\n");
+    }
+
+    put32(&p_image[BLOB_SIZE], FS_MAGIC);
+    put32(&p_image[BLOB_SIZE + 4U], count);
+    put32(&p_image[BLOB_SIZE + 8U], 0U);
+    put32(&p_image[BLOB_SIZE + 12U], 0U);
+
+    printf("%-24s %-10s %-10s %-10s %-10s\n", "name", "hash", "offset", "size", "crc");
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        const asset_t *p_asset = &p_assets[index];
+        uint8_t *p_entry = &p_image[BLOB_SIZE + FS_HEADER_SIZE + (index * FS_ENTRY_SIZE)];
+
+        put32(&p_entry[0U], p_asset->hash);
+        put32(&p_entry[4U], p_asset->offset);
+        put32(&p_entry[8U], p_asset->size);
+        put32(&p_entry[12U], p_asset->crc);
+        put32(&p_entry[16U], p_asset->format);
+        put32(&p_entry[20U], p_asset->ram_size);
+        put32(&p_entry[24U], (p_asset->width & 0xFFFFUL) | (p_asset->height << 16U));
+        put32(&p_entry[28U], 0U);
+        memcpy(&p_image[p_asset->offset], p_asset->p_data, p_asset->size);
+
+        printf("%-24s 0x%08lx 0x%08lx %-10lu 0x%08lx\n", p_asset->p_name, (unsigned long) p_asset->hash,
+               (unsigned long) p_asset->offset, (unsigned long) p_asset->size, (unsigned long) p_asset->crc);
+    }
+
+    p_file = fopen(p_output, "wb");
+    if ((NULL == p_file) || (fwrite(p_image, 1U, image_size, p_file) != image_size))
+    {
+        fprintf(stderr, "%s: could not write\n", p_output);
+        return (EXIT_FAILURE);
+    }
+    fclose(p_file);
+    printf("%lu assets, %lu bytes\n", (unsigned long) count, (unsigned long) image_size);
+
+    return (EXIT_SUCCESS);
+}
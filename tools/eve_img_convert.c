@@ -0,0 +1,975 @@
+/*
+@file    eve_img_convert.c
+@brief   convert PNG and BMP images to EVE bitmap formats, compressed for CMD_INFLATE, with a cost report
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+Reads a PNG (8 or 16 bit, grey, RGB, palette, with or without alpha, not interlaced) or an
+uncompressed 24/32 bit BMP and writes a header in the style of tft_data.c with the bitmap
+compressed with zlib for EVE_cmd_inflate(), plus a report with the RAM_G footprint,
+the bytes sent over SPI and the cost of rendering for every variant, to pick the cheapest
+format per image.
+
+The render cost is the number of bits the bitmap engine reads per pixel drawn,
+PALETTED8 needs one pass per color channel and reads the palette for each.
+ASTC is only listed in the report, use astcenc or EAB to encode it, the blocks
+are not worth compressing and are usually loaded from the flash.
+
+Build:
+gcc -std=c99 -Wall -Wextra -O2 -o eve_img_convert eve_img_convert.c -lz
+
+Use:
+./eve_img_convert [-f format] [-n name] [-o output.h] image.png
+./eve_img_convert -f ARGB4 -n icons -o icons.h home.png settings.png back.png
+
+format is one of ARGB1555, ARGB4, RGB565, L8 and PALETTED8, without -f only the report is printed.
+L8 uses the alpha channel of images with transparency, the luminance otherwise.
+
+More than one image is packed into an atlas: every image is centered in a cell of the size of the
+largest one and the cells are stacked, this is the layout the bitmap engine uses for the cell
+argument of VERTEX2II and CELL. The header has NAME_CELLS and NAME_CELL_FILENAME for each image,
+the atlas is drawn with the functions in src/EVE_sprite.c, up to 128 cells.
+
+@section History
+
+5.0
+- initial version
+- added atlas mode for more than one image
+
+*/
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+#define FORMAT_ARGB1555 0U
+#define FORMAT_L8 3U
+#define FORMAT_ARGB4 6U
+#define FORMAT_RGB565 7U
+#define FORMAT_PALETTED8 16U
+#define FORMAT_NONE 0xFFU
+
+typedef struct
+{
+    uint32_t width;
+    uint32_t height;
+    uint8_t *p_rgba; /* 4 bytes per pixel, R G B A */
+} image_t;
+
+typedef struct
+{
+    const char *p_name;
+    uint8_t format;
+    uint8_t bits; /* per pixel */
+} format_t;
+
+static const format_t formats[] =
+{
+    {"ARGB1555", FORMAT_ARGB1555, 16U}, {"ARGB4", FORMAT_ARGB4, 16U}, {"RGB565", FORMAT_RGB565, 16U},
+    {"L8", FORMAT_L8, 8U}, {"PALETTED8", FORMAT_PALETTED8, 8U}
+};
+
+static const struct
+{
+    const char *p_name;
+    uint8_t block_w;
+    uint8_t block_h;
+} astc_formats[] =
+{
+    {"ASTC_4X4", 4U, 4U}, {"ASTC_5X5", 5U, 5U}, {"ASTC_6X6", 6U, 6U}, {"ASTC_8X8", 8U, 8U},
+    {"ASTC_10X10", 10U, 10U}, {"ASTC_12X12", 12U, 12U}
+};
+
+static uint8_t *load_file(const char *p_path, uint32_t *p_size)
+{
+    FILE *p_file = fopen(p_path, "rb");
+    uint8_t *p_data = NULL;
+    long size;
+
+    if (p_file != NULL)
+    {
+        fseek(p_file, 0L, SEEK_END);
+        size = ftell(p_file);
+        fseek(p_file, 0L, SEEK_SET);
+        p_data = malloc((size_t) size + 1U);
+        if ((p_data != NULL) && (fread(p_data, 1U, (size_t) size, p_file) != (size_t) size))
+        {
+            free(p_data);
+            p_data = NULL;
+        }
+        *p_size = (uint32_t) size;
+        fclose(p_file);
+    }
+    return (p_data);
+}
+
+static uint32_t get32be(const uint8_t *p_data)
+{
+    return (((uint32_t) p_data[0U] << 24U) | ((uint32_t) p_data[1U] << 16U) |
+            ((uint32_t) p_data[2U] << 8U) | p_data[3U]);
+}
+
+static uint32_t get32le(const uint8_t *p_data)
+{
+    return (((uint32_t) p_data[3U] << 24U) | ((uint32_t) p_data[2U] << 16U) |
+            ((uint32_t) p_data[1U] << 8U) | p_data[0U]);
+}
+
+static uint8_t paeth(uint8_t left, uint8_t up, uint8_t up_left)
+{
+    int const estimate = (int) left + (int) up - (int) up_left;
+    int const dist_left = abs(estimate - (int) left);
+    int const dist_up = abs(estimate - (int) up);
+    int const dist_up_left = abs(estimate - (int) up_left);
+    uint8_t ret = up_left;
+
+    if ((dist_left <= dist_up) && (dist_left <= dist_up_left))
+    {
+        ret = left;
+    }
+    else if (dist_up <= dist_up_left)
+    {
+        ret = up;
+    }
+    return (ret);
+}
+
+/* read one sample from a row, "depth" is 1, 2, 4, 8 or 16 bits, 16 bit samples are cut to 8 */
+static uint8_t png_sample(const uint8_t *p_row, uint32_t index, uint8_t depth)
+{
+    uint8_t ret;
+
+    if (depth >= 8U)
+    {
+        ret = p_row[index * (depth / 8U)];
+    }
+    else
+    {
+        uint32_t const bit = index * depth;
+        uint8_t const mask = (uint8_t) ((1U << depth) - 1U);
+
+        ret = (uint8_t) ((p_row[bit / 8U] >> (8U - depth - (bit % 8U))) & mask);
+    }
+    return (ret);
+}
+
+static int load_png(const uint8_t *p_data, uint32_t size, image_t *p_image)
+{
+    static const uint8_t channels_of[7U] = {1U, 0U, 3U, 1U, 2U, 0U, 4U};
+    uint8_t palette[256U][4U];
+    uint8_t *p_idat = NULL;
+    uint32_t idat_size = 0U;
+    uint32_t pos = 8U;
+    uint8_t depth = 0U;
+    uint8_t type = 0U;
+    uint8_t channels;
+    uint32_t trns_grey = 0x10000UL; /* none */
+    uint32_t row_bytes;
+    uint32_t pixel_bytes;
+    uint8_t *p_raw;
+    uLongf raw_size;
+
+    memset(palette, 0xFF, sizeof(palette));
+    p_image->width = 0U;
+
+    while ((pos + 12U) <= size)
+    {
+        uint32_t const len = get32be(&p_data[pos]);
+        const uint8_t *p_chunk = &p_data[pos + 8U];
+
+        if ((pos + 12U + len) > size)
+        {
+            break;
+        }
+        if (0 == memcmp(&p_data[pos + 4U], "IHDR", 4U))
+        {
+            p_image->width = get32be(p_chunk);
+            p_image->height = get32be(&p_chunk[4U]);
+            depth = p_chunk[8U];
+            type = p_chunk[9U];
+            if ((p_chunk[12U] != 0U) || (type > 6U) || (0U == channels_of[type]))
+            {
+                fprintf(stderr, "interlaced or unknown PNG color type\n");
+                return (-1);
+            }
+        }
+        else if (0 == memcmp(&p_data[pos + 4U], "PLTE", 4U))
+        {
+            for (uint32_t index = 0U; (index < (len / 3U)) && (index < 256U); index++)
+            {
+                palette[index][0U] = p_chunk[index * 3U];
+                palette[index][1U] = p_chunk[(index * 3U) + 1U];
+                palette[index][2U] = p_chunk[(index * 3U) + 2U];
+            }
+        }
+        else if (0 == memcmp(&p_data[pos + 4U], "tRNS", 4U))
+        {
+            if (3U == type)
+            {
+                for (uint32_t index = 0U; (index < len) && (index < 256U); index++)
+                {
+                    palette[index][3U] = p_chunk[index];
+                }
+            }
+            else if ((0U == type) && (len >= 2U))
+            {
+                trns_grey = ((uint32_t) p_chunk[0U] << 8U) | p_chunk[1U];
+            }
+        }
+        else if (0 == memcmp(&p_data[pos + 4U], "IDAT", 4U))
+        {
+            uint8_t *p_new = realloc(p_idat, idat_size + len);
+
+            if (NULL == p_new)
+            {
+                free(p_idat);
+                return (-1);
+            }
+            p_idat = p_new;
+            memcpy(&p_idat[idat_size], p_chunk, len);
+            idat_size += len;
+        }
+        else if (0 == memcmp(&p_data[pos + 4U], "IEND", 4U))
+        {
+            break;
+        }
+        pos += 12U + len;
+    }
+
+    if ((0U == p_image->width) || (NULL == p_idat))
+    {
+        free(p_idat);
+        fprintf(stderr, "no image data in PNG\n");
+        return (-1);
+    }
+
+    channels = channels_of[type];
+    row_bytes = ((p_image->width * channels * depth) + 7U) / 8U;
+    pixel_bytes = ((channels * depth) + 7U) / 8U;
+    raw_size = (uLongf) (row_bytes + 1U) * p_image->height;
+    p_raw = malloc(raw_size);
+    p_image->p_rgba = malloc((size_t) p_image->width * p_image->height * 4U);
+
+    if ((NULL == p_raw) || (NULL == p_image->p_rgba) ||
+        (uncompress(p_raw, &raw_size, p_idat, idat_size) != Z_OK))
+    {
+        free(p_idat);
+        free(p_raw);
+        fprintf(stderr, "PNG data is corrupt\n");
+        return (-1);
+    }
+    free(p_idat);
+
+    for (uint32_t y = 0U; y < p_image->height; y++)
+    {
+        uint8_t *p_row = &p_raw[(y * (row_bytes + 1U)) + 1U];
+        const uint8_t *p_prev = (y > 0U) ? &p_raw[((y - 1U) * (row_bytes + 1U)) + 1U] : NULL;
+        uint8_t const filter = p_row[-1];
+
+        for (uint32_t x = 0U; x < row_bytes; x++)
+        {
+            uint8_t const left = (x >= pixel_bytes) ? p_row[x - pixel_bytes] : 0U;
+            uint8_t const up = (p_prev != NULL) ? p_prev[x] : 0U;
+            uint8_t const up_left = ((p_prev != NULL) && (x >= pixel_bytes)) ? p_prev[x - pixel_bytes] : 0U;
+
+            switch (filter)
+            {
+                case 1U: p_row[x] += left; break;
+                case 2U: p_row[x] += up; break;
+                case 3U: p_row[x] += (uint8_t) (((uint32_t) left + up) / 2U); break;
+                case 4U: p_row[x] += paeth(left, up, up_left); break;
+                default: break;
+            }
+        }
+
+        for (uint32_t x = 0U; x < p_image->width; x++)
+        {
+            uint8_t *p_pixel = &p_image->p_rgba[((y * p_image->width) + x) * 4U];
+            uint32_t const sample = x * channels;
+
+            if (3U == type)
+            {
+                memcpy(p_pixel, palette[png_sample(p_row, x, depth)], 4U);
+            }
+            else if ((0U == type) || (4U == type))
+            {
+                uint8_t grey = png_sample(p_row, sample, depth);
+                uint32_t const raw = (16U == depth) ?
+                    (((uint32_t) grey << 8U) | p_row[(sample * 2U) + 1U]) : grey;
+
+                if (depth < 8U)
+                {
+                    grey = (uint8_t) ((grey * 255U) / ((1U << depth) - 1U));
+                }
+                p_pixel[0U] = grey;
+                p_pixel[1U] = grey;
+                p_pixel[2U] = grey;
+                p_pixel[3U] = (4U == type) ? png_sample(p_row, sample + 1U, depth) :
+                              ((raw == trns_grey) ? 0U : 255U);
+            }
+            else
+            {
+                p_pixel[0U] = png_sample(p_row, sample, depth);
+                p_pixel[1U] = png_sample(p_row, sample + 1U, depth);
+                p_pixel[2U] = png_sample(p_row, sample + 2U, depth);
+                p_pixel[3U] = (6U == type) ? png_sample(p_row, sample + 3U, depth) : 255U;
+            }
+        }
+    }
+    free(p_raw);
+    return (0);
+}
+
+static int load_bmp(const uint8_t *p_data, uint32_t size, image_t *p_image)
+{
+    uint32_t const offset = get32le(&p_data[10U]);
+    int32_t const height = (int32_t) get32le(&p_data[22U]);
+    uint16_t const bits = (uint16_t) (p_data[28U] | ((uint16_t) p_data[29U] << 8U));
+    uint32_t const compression = get32le(&p_data[30U]);
+    uint32_t row_bytes;
+
+    p_image->width = get32le(&p_data[18U]);
+    p_image->height = (uint32_t) ((height < 0) ? -height : height);
+    row_bytes = ((p_image->width * (bits / 8U)) + 3U) & ~3UL;
+
+    if (((bits != 24U) && (bits != 32U)) || ((compression != 0U) && (compression != 3U)) ||
+        ((offset + (row_bytes * p_image->height)) > size))
+    {
+        fprintf(stderr, "only uncompressed 24 and 32 bit BMP files are supported\n");
+        return (-1);
+    }
+
+    p_image->p_rgba = malloc((size_t) p_image->width * p_image->height * 4U);
+    if (NULL == p_image->p_rgba)
+    {
+        return (-1);
+    }
+
+    for (uint32_t y = 0U; y < p_image->height; y++)
+    {
+        uint32_t const line = (height < 0) ? y : (p_image->height - 1U - y); /* bottom-up unless negative */
+        const uint8_t *p_row = &p_data[offset + (line * row_bytes)];
+
+        for (uint32_t x = 0U; x < p_image->width; x++)
+        {
+            uint8_t *p_pixel = &p_image->p_rgba[((y * p_image->width) + x) * 4U];
+            const uint8_t *p_source = &p_row[x * (bits / 8U)];
+
+            p_pixel[0U] = p_source[2U];
+            p_pixel[1U] = p_source[1U];
+            p_pixel[2U] = p_source[0U];
+            p_pixel[3U] = (32U == bits) ? p_source[3U] : 255U;
+        }
+    }
+    return (0);
+}
+
+static int has_alpha(const image_t *p_image)
+{
+    for (uint32_t index = 0U; index < (p_image->width * p_image->height); index++)
+    {
+        if (p_image->p_rgba[(index * 4U) + 3U] != 255U)
+        {
+            return (1);
+        }
+    }
+    return (0);
+}
+
+/* median cut to 256 colors, images with up to 256 colors are kept exact */
+static uint8_t quant_channel;
+
+static int compare_channel(const void *p_a, const void *p_b)
+{
+    uint8_t const value_a = ((const uint8_t *) p_a)[quant_channel];
+    uint8_t const value_b = ((const uint8_t *) p_b)[quant_channel];
+
+    return ((int) value_a - (int) value_b);
+}
+
+static int compare_u32(const void *p_a, const void *p_b)
+{
+    uint32_t const value_a = *(const uint32_t *) p_a;
+    uint32_t const value_b = *(const uint32_t *) p_b;
+
+    return ((value_a > value_b) - (value_a < value_b));
+}
+
+static uint32_t build_palette(const image_t *p_image, uint8_t palette[256U][4U])
+{
+    uint32_t const pixels = p_image->width * p_image->height;
+    uint32_t *p_colors = malloc((size_t) pixels * 4U);
+    uint32_t box_start[257U];
+    uint32_t count = 0U;
+    uint32_t unique = 0U;
+
+    if (NULL == p_colors)
+    {
+        return (0U);
+    }
+    memcpy(p_colors, p_image->p_rgba, (size_t) pixels * 4U);
+    qsort(p_colors, pixels, 4U, compare_u32);
+    for (uint32_t index = 0U; index < pixels; index++)
+    {
+        if ((0U == index) || (p_colors[index] != p_colors[index - 1U]))
+        {
+            if (unique < 256U)
+            {
+                memcpy(palette[unique], &p_colors[index], 4U);
+            }
+            unique++;
+        }
+    }
+
+    if (unique <= 256U)
+    {
+        free(p_colors);
+        return (unique);
+    }
+
+    box_start[0U] = 0U;
+    box_start[1U] = pixels;
+    count = 1U;
+
+    while (count < 256U)
+    {
+        uint32_t best = count;
+        uint32_t best_score = 0U;
+        uint8_t best_channel = 0U;
+
+        for (uint32_t box = 0U; box < count; box++)
+        {
+            const uint8_t *p_first = (const uint8_t *) &p_colors[box_start[box]];
+            uint32_t const num = box_start[box + 1U] - box_start[box];
+
+            for (uint8_t channel = 0U; (channel < 4U) && (num > 1U); channel++)
+            {
+                uint8_t low = 255U;
+                uint8_t high = 0U;
+
+                for (uint32_t index = 0U; index < num; index++)
+                {
+                    uint8_t const value = p_first[(index * 4U) + channel];
+
+                    low = (value < low) ? value : low;
+                    high = (value > high) ? value : high;
+                }
+                if (((uint32_t) (high - low) * num) > best_score)
+                {
+                    best_score = (uint32_t) (high - low) * num;
+                    best = box;
+                    best_channel = channel;
+                }
+            }
+        }
+
+        if (best == count)
+        {
+            break;
+        }
+
+        quant_channel = best_channel;
+        qsort(&p_colors[box_start[best]], box_start[best + 1U] - box_start[best], 4U, compare_channel);
+        memmove(&box_start[best + 2U], &box_start[best + 1U], (count - best) * sizeof(uint32_t));
+        box_start[best + 1U] = (box_start[best] + box_start[best + 2U]) / 2U;
+        count++;
+    }
+
+    for (uint32_t box = 0U; box < count; box++)
+    {
+        uint32_t sum[4U] = {0U, 0U, 0U, 0U};
+        uint32_t const num = box_start[box + 1U] - box_start[box];
+
+        for (uint32_t index = box_start[box]; index < box_start[box + 1U]; index++)
+        {
+            const uint8_t *p_color = (const uint8_t *) &p_colors[index];
+
+            for (uint8_t channel = 0U; channel < 4U; channel++)
+            {
+                sum[channel] += p_color[channel];
+            }
+        }
+        for (uint8_t channel = 0U; channel < 4U; channel++)
+        {
+            palette[box][channel] = (uint8_t) ((sum[channel] + (num / 2U)) / num);
+        }
+    }
+    free(p_colors);
+    return (count);
+}
+
+static uint8_t nearest(uint8_t palette[256U][4U], uint32_t colors, const uint8_t *p_pixel)
+{
+    uint32_t best_distance = 0xFFFFFFFFUL;
+    uint8_t best = 0U;
+
+    for (uint32_t index = 0U; index < colors; index++)
+    {
+        uint32_t distance = 0U;
+
+        for (uint8_t channel = 0U; channel < 4U; channel++)
+        {
+            int const diff = (int) palette[index][channel] - (int) p_pixel[channel];
+
+            distance += (uint32_t) (diff * diff);
+        }
+        if (distance < best_distance)
+        {
+            best_distance = distance;
+            best = (uint8_t) index;
+        }
+    }
+    return (best);
+}
+
+/* convert to one of the formats, for PALETTED8 the 1024 bytes palette is returned in p_lut */
+static uint8_t *convert(const image_t *p_image, const format_t *p_format, uint32_t *p_size, uint8_t *p_lut)
+{
+    uint32_t const pixels = p_image->width * p_image->height;
+    int const alpha = has_alpha(p_image);
+    uint8_t palette[256U][4U];
+    uint32_t colors = 0U;
+    uint8_t *p_out;
+
+    *p_size = pixels * (p_format->bits / 8U);
+    p_out = malloc(*p_size);
+    if (NULL == p_out)
+    {
+        return (NULL);
+    }
+
+    if (FORMAT_PALETTED8 == p_format->format)
+    {
+        memset(palette, 0, sizeof(palette));
+        colors = build_palette(p_image, palette);
+        for (uint32_t index = 0U; index < 256U; index++) /* ARGB8888, little endian */
+        {
+            p_lut[(index * 4U)] = palette[index][2U];
+            p_lut[(index * 4U) + 1U] = palette[index][1U];
+            p_lut[(index * 4U) + 2U] = palette[index][0U];
+            p_lut[(index * 4U) + 3U] = palette[index][3U];
+        }
+    }
+
+    for (uint32_t index = 0U; index < pixels; index++)
+    {
+        const uint8_t *p_pixel = &p_image->p_rgba[index * 4U];
+        uint32_t const red = p_pixel[0U];
+        uint32_t const green = p_pixel[1U];
+        uint32_t const blue = p_pixel[2U];
+        uint32_t const alpha_value = p_pixel[3U];
+        uint32_t value = 0U;
+
+        switch (p_format->format)
+        {
+            case FORMAT_ARGB1555:
+                value = ((alpha_value >= 128U) ? 0x8000U : 0U) | ((red >> 3U) << 10U) | ((green >> 3U) << 5U) | (blue >> 3U);
+                break;
+            case FORMAT_ARGB4:
+                value = ((alpha_value >> 4U) << 12U) | ((red >> 4U) << 8U) | ((green >> 4U) << 4U) | (blue >> 4U);
+                break;
+            case FORMAT_RGB565:
+                value = ((red >> 3U) << 11U) | ((green >> 2U) << 5U) | (blue >> 3U);
+                break;
+            case FORMAT_L8:
+                value = (alpha != 0) ? alpha_value : (((red * 77U) + (green * 150U) + (blue * 29U)) >> 8U);
+                break;
+            default:
+                value = nearest(palette, colors, p_pixel);
+                break;
+        }
+
+        if (16U == p_format->bits)
+        {
+            p_out[index * 2U] = (uint8_t) value;
+            p_out[(index * 2U) + 1U] = (uint8_t) (value >> 8U);
+        }
+        else
+        {
+            p_out[index] = (uint8_t) value;
+        }
+    }
+    return (p_out);
+}
+
+/* zlib stream as expected by CMD_INFLATE */
+static uint8_t *deflate_data(const uint8_t *p_data, uint32_t size, uint32_t *p_packed)
+{
+    uLongf packed = compressBound(size);
+    uint8_t *p_out = malloc(packed);
+
+    if ((p_out != NULL) && (compress2(p_out, &packed, p_data, size, Z_BEST_COMPRESSION) != Z_OK))
+    {
+        free(p_out);
+        p_out = NULL;
+    }
+    *p_packed = (uint32_t) packed;
+    return (p_out);
+}
+
+static void write_array(FILE *p_file, const char *p_name, const uint8_t *p_data, uint32_t size)
+{
+    fprintf(p_file, "const uint8_t %s[%lu] PROGMEM =\n{\n", p_name, (unsigned long) size);
+    for (uint32_t index = 0U; index < size; index++)
+    {
+        if (0U == (index % 32U))
+        {
+            fprintf(p_file, "    ");
+        }
+        fprintf(p_file, "0x%x", p_data[index]);
+        if ((index + 1U) < size)
+        {
+            fprintf(p_file, ((index % 32U) == 31U) ? ",\n" : ", ");
+        }
+    }
+    fprintf(p_file, "\n};\n\n");
+}
+
+static int write_header(const char *p_path, const char *p_name, const image_t *p_image, const format_t *p_format,
+                        const uint8_t *p_packed, uint32_t packed, uint32_t size,
+                        const uint8_t *p_lut_packed, uint32_t lut_packed, char (*p_cells)[64U], uint32_t cells)
+{
+    FILE *p_file = fopen(p_path, "w");
+    char guard[128U];
+    size_t index;
+
+    if (NULL == p_file)
+    {
+        return (-1);
+    }
+
+    for (index = 0U; (p_name[index] != '\0') && (index < (sizeof(guard) - 3U)); index++)
+    {
+        guard[index] = (char) toupper((unsigned char) p_name[index]);
+    }
+    guard[index] = '\0';
+
+    fprintf(p_file, "#ifndef %s_H\n#define %s_H\n\n", guard, guard);
+    fprintf(p_file, "#if\tdefined (__AVR__)\n    #include <avr/pgmspace.h>\n#else\n    #include <stdint.h>\n"
+                    "    #if !defined(PROGMEM)\n        #define PROGMEM\n    #endif\n#endif\n\n");
+    fprintf(p_file, "#define %s_WIDTH %luU\n#define %s_HEIGHT %luU\n#define %s_FORMAT %uU /* %s */\n"
+                    "#define %s_STRIDE %luU\n#define %s_RAM_SIZE %luUL\n",
+            guard, (unsigned long) p_image->width, guard, (unsigned long) (p_image->height / cells), guard,
+            p_format->format, p_format->p_name, guard, (unsigned long) (p_image->width * (p_format->bits / 8U)),
+            guard, (unsigned long) size);
+
+    if (cells > 1U)
+    {
+        fprintf(p_file, "#define %s_CELLS %luU\n", guard, (unsigned long) cells);
+        for (uint32_t cell = 0U; cell < cells; cell++)
+        {
+            char cell_name[64U];
+
+            for (index = 0U; p_cells[cell][index] != '\0'; index++)
+            {
+                cell_name[index] = (char) toupper((unsigned char) p_cells[cell][index]);
+            }
+            cell_name[index] = '\0';
+            fprintf(p_file, "#define %s_CELL_%s %luU\n", guard, cell_name, (unsigned long) cell);
+        }
+        fprintf(p_file, "\n/* %lu cells of %lux%lu pixel %s in compressed %s format, length is %lu when uncompressed, "
+                        "converted with eve_img_convert */\n",
+                (unsigned long) cells, (unsigned long) p_image->width, (unsigned long) (p_image->height / cells),
+                p_name, p_format->p_name, (unsigned long) size);
+    }
+    else
+    {
+        fprintf(p_file, "\n/* %lux%lu pixel %s in compressed %s format, length is %lu when uncompressed, "
+                        "converted with eve_img_convert */\n",
+                (unsigned long) p_image->width, (unsigned long) p_image->height, p_name, p_format->p_name,
+                (unsigned long) size);
+    }
+    write_array(p_file, p_name, p_packed, packed);
+
+    if (p_lut_packed != NULL)
+    {
+        char lut_name[160U];
+
+        snprintf(lut_name, sizeof(lut_name), "%s_lut", p_name);
+        fprintf(p_file, "/* palette for %s, 256 entries ARGB8888, length is 1024 when uncompressed */\n", p_name);
+        write_array(p_file, lut_name, p_lut_packed, lut_packed);
+    }
+
+    fprintf(p_file, "#endif /* %s_H */\n", guard);
+    fclose(p_file);
+    return (0);
+}
+
+/* the file name without path and extension, usable as C identifier */
+static void base_name(const char *p_path, char *p_name, size_t size)
+{
+    const char *p_base = strrchr(p_path, '/');
+    size_t index;
+
+    p_base = (p_base != NULL) ? (p_base + 1) : p_path;
+    for (index = 0U; (p_base[index] != '\0') && (p_base[index] != '.') && (index < (size - 1U)); index++)
+    {
+        p_name[index] = (char) (isalnum((unsigned char) p_base[index]) ? p_base[index] : '_');
+    }
+    p_name[index] = '\0';
+}
+
+static int load_image(const char *p_path, image_t *p_image)
+{
+    uint32_t file_size;
+    uint8_t *p_file_data = load_file(p_path, &file_size);
+    int ret = -1;
+
+    if ((NULL == p_file_data) || (file_size < 54U))
+    {
+        fprintf(stderr, "%s: could not read\n", p_path);
+    }
+    else if (0 == memcmp(p_file_data, "\x89PNG", 4U))
+    {
+        ret = load_png(p_file_data, file_size, p_image);
+    }
+    else if (0 == memcmp(p_file_data, "BM", 2U))
+    {
+        ret = load_bmp(p_file_data, file_size, p_image);
+    }
+    else
+    {
+        fprintf(stderr, "%s: neither PNG nor BMP\n", p_path);
+    }
+    free(p_file_data);
+    return (ret);
+}
+
+/* stack the images as cells of the size of the largest one, each centered and surrounded by transparent pixels */
+static int build_atlas(const char *p_paths[], uint32_t count, image_t *p_atlas)
+{
+    image_t *p_images = calloc(count, sizeof(image_t));
+    uint32_t cell_height = 0U;
+
+    if (NULL == p_images)
+    {
+        return (-1);
+    }
+
+    p_atlas->width = 0U;
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        if (load_image(p_paths[index], &p_images[index]) != 0)
+        {
+            return (-1);
+        }
+        p_atlas->width = (p_images[index].width > p_atlas->width) ? p_images[index].width : p_atlas->width;
+        cell_height = (p_images[index].height > cell_height) ? p_images[index].height : cell_height;
+    }
+
+    p_atlas->height = cell_height * count;
+    p_atlas->p_rgba = calloc((size_t) p_atlas->width * p_atlas->height, 4U);
+    if (NULL == p_atlas->p_rgba)
+    {
+        return (-1);
+    }
+
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        const image_t *p_image = &p_images[index];
+        uint32_t const left = (p_atlas->width - p_image->width) / 2U;
+        uint32_t const top = (index * cell_height) + ((cell_height - p_image->height) / 2U);
+
+        for (uint32_t y = 0U; y < p_image->height; y++)
+        {
+            memcpy(&p_atlas->p_rgba[(((top + y) * p_atlas->width) + left) * 4U],
+                   &p_image->p_rgba[y * p_image->width * 4U], (size_t) p_image->width * 4U);
+        }
+        free(p_image->p_rgba);
+    }
+    free(p_images);
+    return (0);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *p_inputs[128U];
+    uint32_t inputs = 0U;
+    const char *p_output = NULL;
+    const char *p_format_name = NULL;
+    char name[128U] = "";
+    char cells[128U][64U];
+    const format_t *p_selected = NULL;
+    image_t image = {0U, 0U, NULL};
+    uint8_t lut[1024U];
+    uint32_t lut_packed = 0U;
+    uint8_t *p_lut_packed;
+    uint32_t best_upload = 0xFFFFFFFFUL;
+    const char *p_best_upload = "";
+
+    for (int arg = 1; arg < argc; arg++)
+    {
+        if ((0 == strcmp(argv[arg], "-f")) && ((arg + 1) < argc))
+        {
+            p_format_name = argv[++arg];
+        }
+        else if ((0 == strcmp(argv[arg], "-n")) && ((arg + 1) < argc))
+        {
+            snprintf(name, sizeof(name), "%s", argv[++arg]);
+        }
+        else if ((0 == strcmp(argv[arg], "-o")) && ((arg + 1) < argc))
+        {
+            p_output = argv[++arg];
+        }
+        else if (inputs < 128U)
+        {
+            p_inputs[inputs] = argv[arg];
+            base_name(argv[arg], cells[inputs], sizeof(cells[0U]));
+            inputs++;
+        }
+        else
+        {
+            fprintf(stderr, "an atlas can not have more than 128 cells\n");
+            return (EXIT_FAILURE);
+        }
+    }
+
+    if (p_format_name != NULL)
+    {
+        for (size_t index = 0U; index < (sizeof(formats) / sizeof(formats[0U])); index++)
+        {
+            if (0 == strcmp(p_format_name, formats[index].p_name))
+            {
+                p_selected = &formats[index];
+            }
+        }
+    }
+
+    if ((0U == inputs) || ((p_format_name != NULL) && (NULL == p_selected)) ||
+        ((p_output != NULL) && (NULL == p_selected)) || ((inputs > 1U) && ('\0' == name[0U])))
+    {
+        fprintf(stderr, "usage: %s [-f ARGB1555|ARGB4|RGB565|L8|PALETTED8] [-n name] [-o output.h] image ...\n", argv[0]);
+        fprintf(stderr, "more than one image is stored as cells of an atlas, -n is needed then\n");
+        return (EXIT_FAILURE);
+    }
+
+    if ('\0' == name[0U])
+    {
+        base_name(p_inputs[0U], name, sizeof(name));
+    }
+
+    if (1U == inputs)
+    {
+        if (load_image(p_inputs[0U], &image) != 0)
+        {
+            return (EXIT_FAILURE);
+        }
+        printf("%s: ", p_inputs[0U]);
+    }
+    else
+    {
+        if (build_atlas(p_inputs, inputs, &image) != 0)
+        {
+            return (EXIT_FAILURE);
+        }
+        printf("%s: %lu cells of %lux%lu, ", name, (unsigned long) inputs, (unsigned long) image.width,
+               (unsigned long) (image.height / inputs));
+    }
+
+    printf("%lux%lu pixel%s\n\n", (unsigned long) image.width, (unsigned long) image.height,
+           has_alpha(&image) ? ", with transparency" : "");
+    printf("%-11s %10s %10s %10s %10s\n", "format", "RAM_G", "upload", "bits/px", "passes");
+
+    for (size_t index = 0U; index < (sizeof(formats) / sizeof(formats[0U])); index++)
+    {
+        const format_t *p_format = &formats[index];
+        uint32_t size;
+        uint32_t packed;
+        uint32_t ram = 0U;
+        uint32_t upload;
+        uint8_t *p_data = convert(&image, p_format, &size, lut);
+        uint8_t *p_packed = (p_data != NULL) ? deflate_data(p_data, size, &packed) : NULL;
+        uint32_t bits = p_format->bits;
+        uint32_t passes = 1U;
+
+        if (NULL == p_packed)
+        {
+            fprintf(stderr, "out of memory\n");
+            return (EXIT_FAILURE);
+        }
+
+        ram = size;
+        upload = packed + 12U; /* CMD_INFLATE + address + padding */
+        p_lut_packed = NULL;
+        if (FORMAT_PALETTED8 == p_format->format)
+        {
+            p_lut_packed = deflate_data(lut, sizeof(lut), &lut_packed);
+            ram += sizeof(lut);
+            upload += lut_packed + 12U;
+            bits = 4U * (8U + 32U); /* index and palette entry, once per channel */
+            passes = 4U;
+        }
+
+        printf("%-11s %10lu %10lu %10lu %10lu\n", p_format->p_name, (unsigned long) ram, (unsigned long) upload,
+               (unsigned long) bits, (unsigned long) passes);
+        if (upload < best_upload)
+        {
+            best_upload = upload;
+            p_best_upload = p_format->p_name;
+        }
+
+        if ((p_format == p_selected) && (p_output != NULL))
+        {
+            if (write_header(p_output, name, &image, p_format, p_packed, packed, size, p_lut_packed, lut_packed,
+                             cells, inputs) != 0)
+            {
+                fprintf(stderr, "%s: could not write\n", p_output);
+                return (EXIT_FAILURE);
+            }
+        }
+        free(p_lut_packed);
+        free(p_packed);
+        free(p_data);
+    }
+
+    for (size_t index = 0U; index < (sizeof(astc_formats) / sizeof(astc_formats[0U])); index++)
+    {
+        uint32_t const blocks_w = (image.width + astc_formats[index].block_w - 1U) / astc_formats[index].block_w;
+        uint32_t const blocks_h = (image.height + astc_formats[index].block_h - 1U) / astc_formats[index].block_h;
+        uint32_t const size = blocks_w * blocks_h * 16U;
+        double const bits = 128.0 / (astc_formats[index].block_w * astc_formats[index].block_h);
+
+        printf("%-11s %10lu %10lu %10.2f %10u\n", astc_formats[index].p_name, (unsigned long) size,
+               (unsigned long) (size + 12U), bits, 1U);
+    }
+
+    printf("\nupload: bytes over SPI with CMD_INFLATE (ASTC uncompressed with CMD_MEMWRITE or 0 from the flash)\n");
+    printf("bits/px: read by the bitmap engine per pixel drawn, ASTC is RGBA and can be drawn from the flash\n");
+    printf("smallest upload: %s\n", p_best_upload);
+    if ((p_selected != NULL) && (p_output != NULL))
+    {
+        printf("wrote %s as %s to %s\n", name, p_selected->p_name, p_output);
+    }
+
+    free(image.p_rgba);
+    return (EXIT_SUCCESS);
+}
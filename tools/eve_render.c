@@ -0,0 +1,1174 @@
+/*
+@file    eve_render.c
+@brief   software renderer for EVE display lists, to compare frames against golden images
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+Executes the display list of a frame file written by eve_sim_socket into a framebuffer and
+writes it as PNG, compares it with a golden PNG and reports what the frame costs to render.
+This is a reference for regression tests of the host side, not a bit exact model of EVE:
+anti-aliasing is approximated and widgets, fonts from ROM, ASTC and the TEXT8X8, TEXTVGA and
+BARGRAPH formats are not drawn, the number of coprocessor commands that were not drawn
+is in the frame file and reported.
+
+Supported: CLEAR and the clear values, COLOR_RGB / COLOR_A, POINTS, LINES, LINE_STRIP,
+EDGE_STRIP_R/L/A/B, RECTS, BITMAPS with all other formats, cells, the bitmap transform,
+BORDER / REPEAT and NEAREST, SCISSOR, ALPHA_FUNC, STENCIL_FUNC / STENCIL_OP / STENCIL_MASK,
+BLEND_FUNC, COLOR_MASK, SAVE_CONTEXT / RESTORE_CONTEXT, JUMP, CALL / RETURN, MACRO,
+VERTEX_FORMAT and VERTEX_TRANSLATE.
+
+The report lists the number of fragments per primitive type, the bytes the bitmap engine
+reads and the overdraw, the average number of fragments per pixel of the screen.
+
+Build:
+gcc -std=c99 -Wall -Wextra -O2 -o eve_render eve_render.c -lz -lm
+
+Use:
+./eve_render [-o frame.png] [-c golden.png] [-t tolerance] [-d diff.png] frame.evf
+
+With -c the exit code is 1 if any channel of any pixel differs by more than the tolerance.
+
+@section History
+
+5.0
+- initial version
+
+*/
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+#define HEADER_SIZE 36U
+#define RAM_DL_SIZE 8192U
+#define RAM_G_SIZE 0x100000UL
+#define CONTEXT_DEPTH 4U
+
+enum
+{
+    PRIM_NONE = 0, PRIM_BITMAPS, PRIM_POINTS, PRIM_LINES, PRIM_LINE_STRIP, PRIM_EDGE_STRIP_R,
+    PRIM_EDGE_STRIP_L, PRIM_EDGE_STRIP_A, PRIM_EDGE_STRIP_B, PRIM_RECTS, PRIM_COUNT
+};
+
+static const char *prim_names[PRIM_COUNT] =
+{
+    "none", "BITMAPS", "POINTS", "LINES", "LINE_STRIP", "EDGE_STRIP_R", "EDGE_STRIP_L", "EDGE_STRIP_A",
+    "EDGE_STRIP_B", "RECTS"
+};
+
+typedef struct
+{
+    uint8_t color[4U];       /* r g b a */
+    uint8_t clear_color[4U];
+    uint8_t clear_stencil;
+    int32_t point_size;      /* 1/16 pixel */
+    int32_t line_width;      /* 1/16 pixel */
+    uint8_t alpha_func;
+    uint8_t alpha_ref;
+    uint8_t stencil_func;
+    uint8_t stencil_ref;
+    uint8_t stencil_mask;
+    uint8_t stencil_fail;
+    uint8_t stencil_pass;
+    uint8_t stencil_write;
+    uint8_t blend_src;
+    uint8_t blend_dst;
+    uint8_t color_mask;      /* r g b a in bits 3...0 */
+    int32_t scissor_x;
+    int32_t scissor_y;
+    int32_t scissor_w;
+    int32_t scissor_h;
+    uint8_t handle;
+    uint8_t cell;
+    uint8_t vertex_frac;
+    int32_t translate_x;     /* 1/16 pixel */
+    int32_t translate_y;
+    double transform[6U];    /* a b c d e f */
+    uint32_t palette;
+} context_t;
+
+typedef struct
+{
+    uint32_t source;
+    uint32_t format;
+    uint32_t stride;
+    uint32_t layout_height;
+    uint32_t filter;
+    uint32_t wrap_x;
+    uint32_t wrap_y;
+    uint32_t width;
+    uint32_t height;
+    uint32_t ext_format;
+} handle_t;
+
+typedef struct
+{
+    uint32_t width;
+    uint32_t height;
+    uint8_t *p_rgba;
+} image_t;
+
+static uint8_t *p_ram_g;
+static uint8_t ram_dl[RAM_DL_SIZE];
+static uint32_t macros[2U];
+static image_t screen;
+static uint8_t *p_stencil;
+static context_t ctx;
+static handle_t handles[32U];
+
+static struct
+{
+    uint64_t fragments[PRIM_COUNT];
+    uint64_t texel_bits;
+    uint32_t primitives[PRIM_COUNT];
+    uint32_t words;
+    uint32_t unsupported;
+} stats;
+
+static uint32_t get32(const uint8_t *p_data)
+{
+    return ((uint32_t) p_data[0U]) | (((uint32_t) p_data[1U]) << 8U) | (((uint32_t) p_data[2U]) << 16U) |
+           (((uint32_t) p_data[3U]) << 24U);
+}
+
+static uint32_t get32be(const uint8_t *p_data)
+{
+    return (((uint32_t) p_data[0U] << 24U) | ((uint32_t) p_data[1U] << 16U) |
+            ((uint32_t) p_data[2U] << 8U) | p_data[3U]);
+}
+
+static int32_t sign_extend(uint32_t value, uint32_t bits)
+{
+    uint32_t const sign = 1UL << (bits - 1U);
+
+    value &= (sign << 1U) - 1U;
+    return ((int32_t) (value ^ sign) - (int32_t) sign);
+}
+
+static void context_reset(void)
+{
+    memset(&ctx, 0, sizeof(ctx));
+    memset(ctx.color, 255, sizeof(ctx.color));
+    ctx.point_size = 16;
+    ctx.line_width = 16;
+    ctx.alpha_func = 7U;
+    ctx.stencil_func = 7U;
+    ctx.stencil_mask = 255U;
+    ctx.stencil_fail = 1U;
+    ctx.stencil_pass = 1U;
+    ctx.stencil_write = 255U;
+    ctx.blend_src = 2U;
+    ctx.blend_dst = 4U;
+    ctx.color_mask = 0x0FU;
+    ctx.scissor_w = 2048;
+    ctx.scissor_h = 2048;
+    ctx.vertex_frac = 4U;
+    ctx.transform[0U] = 1.0;
+    ctx.transform[4U] = 1.0;
+}
+
+static int compare(uint8_t func, uint8_t value, uint8_t ref)
+{
+    int ret;
+
+    switch (func)
+    {
+        case 0U: ret = 0; break;
+        case 1U: ret = (value < ref); break;
+        case 2U: ret = (value <= ref); break;
+        case 3U: ret = (value > ref); break;
+        case 4U: ret = (value >= ref); break;
+        case 5U: ret = (value == ref); break;
+        case 6U: ret = (value != ref); break;
+        default: ret = 1; break;
+    }
+    return (ret);
+}
+
+static uint8_t stencil_apply(uint8_t op, uint8_t value)
+{
+    uint8_t ret = value;
+
+    switch (op)
+    {
+        case 0U: ret = 0U; break;
+        case 2U: ret = ctx.stencil_ref; break;
+        case 3U: ret = (value < 255U) ? (uint8_t) (value + 1U) : value; break;
+        case 4U: ret = (value > 0U) ? (uint8_t) (value - 1U) : value; break;
+        case 5U: ret = (uint8_t) ~value; break;
+        default: break;
+    }
+    return ((uint8_t) ((ret & ctx.stencil_write) | (value & (uint8_t) ~ctx.stencil_write)));
+}
+
+static uint32_t blend_factor(uint8_t factor, uint32_t src_alpha, uint32_t dst_alpha)
+{
+    uint32_t ret;
+
+    switch (factor)
+    {
+        case 0U: ret = 0U; break;
+        case 1U: ret = 255U; break;
+        case 2U: ret = src_alpha; break;
+        case 3U: ret = dst_alpha; break;
+        case 4U: ret = 255U - src_alpha; break;
+        default: ret = 255U - dst_alpha; break;
+    }
+    return (ret);
+}
+
+static int in_scissor(int32_t x, int32_t y)
+{
+    return ((x >= 0) && (y >= 0) && ((uint32_t) x < screen.width) && ((uint32_t) y < screen.height) &&
+            (x >= ctx.scissor_x) && (y >= ctx.scissor_y) &&
+            (x < (ctx.scissor_x + ctx.scissor_w)) && (y < (ctx.scissor_y + ctx.scissor_h)));
+}
+
+/* one fragment thru alpha test, stencil test, blending and the color mask */
+static void fragment(int prim, int32_t x, int32_t y, const uint8_t *p_texel, uint32_t coverage)
+{
+    uint8_t *p_pixel;
+    uint8_t *p_stencil_value;
+    uint32_t src[4U];
+    uint32_t dst_alpha;
+
+    if ((0U == coverage) || (0 == in_scissor(x, y)))
+    {
+        return;
+    }
+
+    stats.fragments[prim]++;
+    p_pixel = &screen.p_rgba[(((uint32_t) y * screen.width) + (uint32_t) x) * 4U];
+    p_stencil_value = &p_stencil[((uint32_t) y * screen.width) + (uint32_t) x];
+
+    for (uint32_t channel = 0U; channel < 4U; channel++)
+    {
+        src[channel] = ((uint32_t) ctx.color[channel] * p_texel[channel] + 127U) / 255U;
+    }
+    src[3U] = ((src[3U] * coverage) + 127U) / 255U;
+
+    if (0 == compare(ctx.alpha_func, (uint8_t) src[3U], ctx.alpha_ref))
+    {
+        return;
+    }
+
+    if (0 == compare(ctx.stencil_func, *p_stencil_value & ctx.stencil_mask, ctx.stencil_ref & ctx.stencil_mask))
+    {
+        *p_stencil_value = stencil_apply(ctx.stencil_fail, *p_stencil_value);
+        return;
+    }
+    *p_stencil_value = stencil_apply(ctx.stencil_pass, *p_stencil_value);
+
+    dst_alpha = p_pixel[3U];
+    for (uint32_t channel = 0U; channel < 4U; channel++)
+    {
+        uint32_t const value = ((src[channel] * blend_factor(ctx.blend_src, src[3U], dst_alpha)) +
+                                (p_pixel[channel] * blend_factor(ctx.blend_dst, src[3U], dst_alpha)) + 127U) / 255U;
+
+        if ((ctx.color_mask & (8U >> channel)) != 0U)
+        {
+            p_pixel[channel] = (uint8_t) ((value > 255U) ? 255U : value);
+        }
+    }
+}
+
+static uint32_t coverage_of(double distance)
+{
+    double value = 0.5 - distance; /* distance to the edge, negative inside */
+
+    value = (value < 0.0) ? 0.0 : ((value > 1.0) ? 1.0 : value);
+    return ((uint32_t) ((value * 255.0) + 0.5));
+}
+
+static const uint8_t opaque[4U] = {255U, 255U, 255U, 255U};
+
+static void draw_point(double cx, double cy)
+{
+    double const radius = ctx.point_size / 16.0;
+
+    for (int32_t y = (int32_t) floor(cy - radius - 1.0); y <= (int32_t) ceil(cy + radius + 1.0); y++)
+    {
+        for (int32_t x = (int32_t) floor(cx - radius - 1.0); x <= (int32_t) ceil(cx + radius + 1.0); x++)
+        {
+            double const dx = (x + 0.5) - cx;
+            double const dy = (y + 0.5) - cy;
+
+            fragment(PRIM_POINTS, x, y, opaque, coverage_of(sqrt((dx * dx) + (dy * dy)) - radius));
+        }
+    }
+}
+
+static void draw_line(int prim, double x0, double y0, double x1, double y1)
+{
+    double const width = ctx.line_width / 16.0;
+    double const length2 = ((x1 - x0) * (x1 - x0)) + ((y1 - y0) * (y1 - y0));
+    int32_t const left = (int32_t) floor(fmin(x0, x1) - width - 1.0);
+    int32_t const right = (int32_t) ceil(fmax(x0, x1) + width + 1.0);
+    int32_t const top = (int32_t) floor(fmin(y0, y1) - width - 1.0);
+    int32_t const bottom = (int32_t) ceil(fmax(y0, y1) + width + 1.0);
+
+    for (int32_t y = top; y <= bottom; y++)
+    {
+        for (int32_t x = left; x <= right; x++)
+        {
+            double const px = x + 0.5;
+            double const py = y + 0.5;
+            double t = (length2 > 0.0) ? ((((px - x0) * (x1 - x0)) + ((py - y0) * (y1 - y0))) / length2) : 0.0;
+            double dx;
+            double dy;
+
+            t = (t < 0.0) ? 0.0 : ((t > 1.0) ? 1.0 : t);
+            dx = px - (x0 + (t * (x1 - x0)));
+            dy = py - (y0 + (t * (y1 - y0)));
+            fragment(prim, x, y, opaque, coverage_of(sqrt((dx * dx) + (dy * dy)) - width));
+        }
+    }
+}
+
+static void draw_rect(double x0, double y0, double x1, double y1)
+{
+    double const left = fmin(x0, x1);
+    double const right = fmax(x0, x1);
+    double const top = fmin(y0, y1);
+    double const bottom = fmax(y0, y1);
+    double const half_w = (right - left) / 2.0;
+    double const half_h = (bottom - top) / 2.0;
+    double radius = ctx.line_width / 16.0;
+
+    radius = fmin(radius, fmin(half_w, half_h));
+    for (int32_t y = (int32_t) floor(top) - 1; y <= (int32_t) ceil(bottom); y++)
+    {
+        for (int32_t x = (int32_t) floor(left) - 1; x <= (int32_t) ceil(right); x++)
+        {
+            double const qx = fabs((x + 0.5) - (left + half_w)) - (half_w - radius);
+            double const qy = fabs((y + 0.5) - (top + half_h)) - (half_h - radius);
+            double const outside = sqrt((fmax(qx, 0.0) * fmax(qx, 0.0)) + (fmax(qy, 0.0) * fmax(qy, 0.0)));
+            double const distance = outside + fmin(fmax(qx, qy), 0.0) - radius;
+
+            fragment(PRIM_RECTS, x, y, opaque, coverage_of(distance));
+        }
+    }
+}
+
+/* fill the side of the segment given by the strip type, within the span of the segment */
+static void draw_edge(int prim, double x0, double y0, double x1, double y1)
+{
+    if ((PRIM_EDGE_STRIP_R == prim) || (PRIM_EDGE_STRIP_L == prim))
+    {
+        double const top = fmin(y0, y1);
+        double const bottom = fmax(y0, y1);
+
+        for (int32_t y = (int32_t) ceil(top - 0.5); (y + 0.5) < bottom; y++)
+        {
+            double const edge = x0 + ((x1 - x0) * (((y + 0.5) - y0) / (y1 - y0)));
+
+            for (int32_t x = 0; x < (int32_t) screen.width; x++)
+            {
+                int const right = ((x + 0.5) >= edge);
+
+                if (right == (PRIM_EDGE_STRIP_R == prim))
+                {
+                    fragment(prim, x, y, opaque, 255U);
+                }
+            }
+        }
+    }
+    else
+    {
+        double const left = fmin(x0, x1);
+        double const right = fmax(x0, x1);
+
+        for (int32_t x = (int32_t) ceil(left - 0.5); (x + 0.5) < right; x++)
+        {
+            double const edge = y0 + ((y1 - y0) * (((x + 0.5) - x0) / (x1 - x0)));
+
+            for (int32_t y = 0; y < (int32_t) screen.height; y++)
+            {
+                int const below = ((y + 0.5) >= edge);
+
+                if (below == (PRIM_EDGE_STRIP_B == prim))
+                {
+                    fragment(prim, x, y, opaque, 255U);
+                }
+            }
+        }
+    }
+}
+
+static uint32_t expand(uint32_t value, uint32_t bits)
+{
+    return ((value * 255U) / ((1U << bits) - 1U));
+}
+
+/* decode one texel to r g b a, returns the number of bits read */
+static uint32_t texel(const handle_t *p_handle, uint32_t address, int32_t u, int32_t v, uint8_t *p_rgba)
+{
+    static const uint8_t bits_of[18U] = {16U, 1U, 4U, 8U, 8U, 8U, 16U, 16U, 8U, 8U, 8U, 8U, 0U, 0U, 8U, 8U, 8U, 2U};
+    uint32_t format = p_handle->format;
+    uint32_t bits;
+    uint32_t offset;
+    uint32_t value;
+
+    if (31U == format)
+    {
+        format = p_handle->ext_format;
+    }
+    if ((format >= 18U) || (0U == bits_of[format]) || (format >= 8U && format <= 11U))
+    {
+        p_rgba[0U] = 255U; /* not supported, magenta */
+        p_rgba[1U] = 0U;
+        p_rgba[2U] = 255U;
+        p_rgba[3U] = 255U;
+        return (0U);
+    }
+
+    bits = bits_of[format];
+    offset = address + ((uint32_t) v * p_handle->stride) + (((uint32_t) u * bits) / 8U);
+    value = p_ram_g[offset & (RAM_G_SIZE - 1U)];
+    if (16U == bits)
+    {
+        value |= ((uint32_t) p_ram_g[(offset + 1U) & (RAM_G_SIZE - 1U)]) << 8U;
+    }
+    else if (bits < 8U)
+    {
+        uint32_t const shift = 8U - bits - (((uint32_t) u * bits) % 8U);
+
+        value = (value >> shift) & ((1U << bits) - 1U);
+    }
+
+    switch (format)
+    {
+        case 0U: /* ARGB1555 */
+            p_rgba[0U] = (uint8_t) expand((value >> 10U) & 31U, 5U);
+            p_rgba[1U] = (uint8_t) expand((value >> 5U) & 31U, 5U);
+            p_rgba[2U] = (uint8_t) expand(value & 31U, 5U);
+            p_rgba[3U] = ((value & 0x8000U) != 0U) ? 255U : 0U;
+            break;
+        case 1U: /* L1 */
+        case 2U: /* L4 */
+        case 3U: /* L8 */
+        case 17U: /* L2 */
+            p_rgba[0U] = 255U;
+            p_rgba[1U] = 255U;
+            p_rgba[2U] = 255U;
+            p_rgba[3U] = (uint8_t) expand(value, bits);
+            break;
+        case 4U: /* RGB332 */
+            p_rgba[0U] = (uint8_t) expand((value >> 5U) & 7U, 3U);
+            p_rgba[1U] = (uint8_t) expand((value >> 2U) & 7U, 3U);
+            p_rgba[2U] = (uint8_t) expand(value & 3U, 2U);
+            p_rgba[3U] = 255U;
+            break;
+        case 5U: /* ARGB2 */
+            p_rgba[3U] = (uint8_t) expand((value >> 6U) & 3U, 2U);
+            p_rgba[0U] = (uint8_t) expand((value >> 4U) & 3U, 2U);
+            p_rgba[1U] = (uint8_t) expand((value >> 2U) & 3U, 2U);
+            p_rgba[2U] = (uint8_t) expand(value & 3U, 2U);
+            break;
+        case 6U: /* ARGB4 */
+            p_rgba[3U] = (uint8_t) expand((value >> 12U) & 15U, 4U);
+            p_rgba[0U] = (uint8_t) expand((value >> 8U) & 15U, 4U);
+            p_rgba[1U] = (uint8_t) expand((value >> 4U) & 15U, 4U);
+            p_rgba[2U] = (uint8_t) expand(value & 15U, 4U);
+            break;
+        case 7U: /* RGB565 */
+            p_rgba[0U] = (uint8_t) expand((value >> 11U) & 31U, 5U);
+            p_rgba[1U] = (uint8_t) expand((value >> 5U) & 63U, 6U);
+            p_rgba[2U] = (uint8_t) expand(value & 31U, 5U);
+            p_rgba[3U] = 255U;
+            break;
+        case 14U: /* PALETTED565 */
+        {
+            uint32_t const entry = get32(&p_ram_g[(ctx.palette + (value * 2U)) & (RAM_G_SIZE - 4U)]) & 0xFFFFU;
+
+            p_rgba[0U] = (uint8_t) expand((entry >> 11U) & 31U, 5U);
+            p_rgba[1U] = (uint8_t) expand((entry >> 5U) & 63U, 6U);
+            p_rgba[2U] = (uint8_t) expand(entry & 31U, 5U);
+            p_rgba[3U] = 255U;
+            bits += 16U;
+            break;
+        }
+        case 15U: /* PALETTED4444 */
+        {
+            uint32_t const entry = get32(&p_ram_g[(ctx.palette + (value * 2U)) & (RAM_G_SIZE - 4U)]) & 0xFFFFU;
+
+            p_rgba[3U] = (uint8_t) expand((entry >> 12U) & 15U, 4U);
+            p_rgba[0U] = (uint8_t) expand((entry >> 8U) & 15U, 4U);
+            p_rgba[1U] = (uint8_t) expand((entry >> 4U) & 15U, 4U);
+            p_rgba[2U] = (uint8_t) expand(entry & 15U, 4U);
+            bits += 16U;
+            break;
+        }
+        default: /* PALETTED8 */
+        {
+            uint32_t const entry = get32(&p_ram_g[(ctx.palette + (value * 4U)) & (RAM_G_SIZE - 4U)]);
+
+            p_rgba[3U] = (uint8_t) (entry >> 24U);
+            p_rgba[0U] = (uint8_t) (entry >> 16U);
+            p_rgba[1U] = (uint8_t) (entry >> 8U);
+            p_rgba[2U] = (uint8_t) entry;
+            bits += 32U;
+            break;
+        }
+    }
+    return (bits);
+}
+
+static void draw_bitmap(double vx, double vy, uint8_t handle, uint8_t cell)
+{
+    const handle_t *p_handle = &handles[handle & 31U];
+    uint32_t const width = (0U == p_handle->width) ? 2048U : p_handle->width;
+    uint32_t const height = (0U == p_handle->height) ? 2048U : p_handle->height;
+    uint32_t const address = p_handle->source + ((uint32_t) cell * p_handle->stride * p_handle->layout_height);
+    int32_t const left = (int32_t) floor(vx);
+    int32_t const top = (int32_t) floor(vy);
+
+    for (int32_t y = top; y < (top + (int32_t) height); y++)
+    {
+        for (int32_t x = left; x < (left + (int32_t) width); x++)
+        {
+            double const px = (x - left) + 0.5;
+            double const py = (y - top) + 0.5;
+            int32_t u = (int32_t) floor((ctx.transform[0U] * px) + (ctx.transform[1U] * py) + ctx.transform[2U]);
+            int32_t v = (int32_t) floor((ctx.transform[3U] * px) + (ctx.transform[4U] * py) + ctx.transform[5U]);
+            uint8_t rgba[4U];
+
+            if (0 == in_scissor(x, y))
+            {
+                continue;
+            }
+
+            if (p_handle->wrap_x != 0U)
+            {
+                u = ((u % (int32_t) width) + (int32_t) width) % (int32_t) width;
+            }
+            if (p_handle->wrap_y != 0U)
+            {
+                v = ((v % (int32_t) height) + (int32_t) height) % (int32_t) height;
+            }
+            if ((u < 0) || (v < 0) || (u >= (int32_t) width) || (v >= (int32_t) height) ||
+                ((uint32_t) v >= p_handle->layout_height))
+            {
+                continue; /* BORDER, transparent */
+            }
+
+            stats.texel_bits += texel(p_handle, address, u, v, rgba);
+            fragment(PRIM_BITMAPS, x, y, rgba, 255U);
+        }
+    }
+}
+
+static void clear(uint32_t word)
+{
+    for (uint32_t y = 0U; y < screen.height; y++)
+    {
+        for (uint32_t x = 0U; x < screen.width; x++)
+        {
+            if (in_scissor((int32_t) x, (int32_t) y))
+            {
+                if ((word & 4U) != 0U)
+                {
+                    memcpy(&screen.p_rgba[((y * screen.width) + x) * 4U], ctx.clear_color, 4U);
+                }
+                if ((word & 2U) != 0U)
+                {
+                    p_stencil[(y * screen.width) + x] = ctx.clear_stencil;
+                }
+            }
+        }
+    }
+}
+
+static void execute(void)
+{
+    context_t stack[CONTEXT_DEPTH];
+    uint32_t calls[CONTEXT_DEPTH];
+    uint32_t stack_depth = 0U;
+    uint32_t call_depth = 0U;
+    int prim = PRIM_NONE;
+    uint32_t vertices = 0U;
+    double last_x = 0.0;
+    double last_y = 0.0;
+    uint32_t pc = 0U;
+    uint32_t budget = 65536U; /* ends lists that loop */
+
+    context_reset();
+    memset(handles, 0, sizeof(handles));
+
+    while ((pc < (RAM_DL_SIZE / 4U)) && (budget > 0U))
+    {
+        uint32_t word = get32(&ram_dl[pc * 4U]);
+        uint32_t const opcode = word >> 24U;
+        handle_t *p_handle = &handles[ctx.handle & 31U];
+        int vertex = 0;
+        double vx = 0.0;
+        double vy = 0.0;
+        uint8_t vertex_handle = ctx.handle;
+        uint8_t vertex_cell = ctx.cell;
+
+        pc++;
+        budget--;
+        stats.words++;
+
+        if (0x25U == opcode) /* MACRO */
+        {
+            word = macros[word & 1U];
+        }
+
+        if ((word & 0xC0000000UL) == 0x40000000UL) /* VERTEX2F */
+        {
+            vertex = 1;
+            vx = (sign_extend(word >> 15U, 15U) * (16.0 / (1U << ctx.vertex_frac)) + ctx.translate_x) / 16.0;
+            vy = (sign_extend(word, 15U) * (16.0 / (1U << ctx.vertex_frac)) + ctx.translate_y) / 16.0;
+        }
+        else if ((word & 0xC0000000UL) == 0x80000000UL) /* VERTEX2II */
+        {
+            vertex = 1;
+            vx = (double) ((word >> 21U) & 0x1FFU) + (ctx.translate_x / 16.0);
+            vy = (double) ((word >> 12U) & 0x1FFU) + (ctx.translate_y / 16.0);
+            vertex_handle = (uint8_t) ((word >> 7U) & 31U);
+            vertex_cell = (uint8_t) (word & 127U);
+        }
+        else
+        {
+            switch (word >> 24U)
+            {
+                case 0x00U: pc = RAM_DL_SIZE; break; /* DISPLAY */
+                case 0x01U: p_handle->source = word & 0xFFFFFFUL; break;
+                case 0x02U:
+                    ctx.clear_color[0U] = (uint8_t) (word >> 16U);
+                    ctx.clear_color[1U] = (uint8_t) (word >> 8U);
+                    ctx.clear_color[2U] = (uint8_t) word;
+                    break;
+                case 0x03U: break; /* TAG */
+                case 0x04U:
+                    ctx.color[0U] = (uint8_t) (word >> 16U);
+                    ctx.color[1U] = (uint8_t) (word >> 8U);
+                    ctx.color[2U] = (uint8_t) word;
+                    break;
+                case 0x05U: ctx.handle = (uint8_t) (word & 31U); break;
+                case 0x06U: ctx.cell = (uint8_t) (word & 127U); break;
+                case 0x07U:
+                    p_handle->format = (word >> 19U) & 31U;
+                    p_handle->stride = (p_handle->stride & 0xC00U) | ((word >> 9U) & 0x3FFU);
+                    p_handle->layout_height = (p_handle->layout_height & 0x600U) | (word & 0x1FFU);
+                    break;
+                case 0x08U:
+                    p_handle->filter = (word >> 20U) & 1U;
+                    p_handle->wrap_x = (word >> 19U) & 1U;
+                    p_handle->wrap_y = (word >> 18U) & 1U;
+                    p_handle->width = (p_handle->width & 0x600U) | ((word >> 9U) & 0x1FFU);
+                    p_handle->height = (p_handle->height & 0x600U) | (word & 0x1FFU);
+                    break;
+                case 0x09U: ctx.alpha_func = (uint8_t) ((word >> 8U) & 7U); ctx.alpha_ref = (uint8_t) word; break;
+                case 0x0AU:
+                    ctx.stencil_func = (uint8_t) ((word >> 16U) & 7U);
+                    ctx.stencil_ref = (uint8_t) (word >> 8U);
+                    ctx.stencil_mask = (uint8_t) word;
+                    break;
+                case 0x0BU: ctx.blend_src = (uint8_t) ((word >> 3U) & 7U); ctx.blend_dst = (uint8_t) (word & 7U); break;
+                case 0x0CU: ctx.stencil_fail = (uint8_t) ((word >> 3U) & 7U); ctx.stencil_pass = (uint8_t) (word & 7U); break;
+                case 0x0DU: ctx.point_size = (int32_t) (word & 0x1FFFU); break;
+                case 0x0EU: ctx.line_width = (int32_t) (word & 0xFFFU); break;
+                case 0x0FU: ctx.clear_color[3U] = (uint8_t) word; break;
+                case 0x10U: ctx.color[3U] = (uint8_t) word; break;
+                case 0x11U: ctx.clear_stencil = (uint8_t) word; break;
+                case 0x12U: break; /* CLEAR_TAG */
+                case 0x13U: ctx.stencil_write = (uint8_t) word; break;
+                case 0x14U: break; /* TAG_MASK */
+                case 0x15U: case 0x16U: case 0x18U: case 0x19U: /* BITMAP_TRANSFORM_A B D E */
+                {
+                    double const value = ((word & 0x20000UL) != 0U) ? (sign_extend(word, 17U) / 32768.0) :
+                                                                       (sign_extend(word, 17U) / 256.0);
+                    ctx.transform[opcode - 0x15U] = value;
+                    break;
+                }
+                case 0x17U: ctx.transform[2U] = sign_extend(word, 24U) / 256.0; break;
+                case 0x1AU: ctx.transform[5U] = sign_extend(word, 24U) / 256.0; break;
+                case 0x1BU:
+                    ctx.scissor_x = (int32_t) ((word >> 11U) & 0x7FFU);
+                    ctx.scissor_y = (int32_t) (word & 0x7FFU);
+                    break;
+                case 0x1CU:
+                    ctx.scissor_w = (int32_t) ((word >> 12U) & 0xFFFU);
+                    ctx.scissor_h = (int32_t) (word & 0xFFFU);
+                    break;
+                case 0x1DU: /* CALL */
+                    if (call_depth < CONTEXT_DEPTH)
+                    {
+                        calls[call_depth++] = pc;
+                    }
+                    pc = word & 0xFFFFU;
+                    break;
+                case 0x1EU: pc = word & 0xFFFFU; break; /* JUMP */
+                case 0x1FU:
+                    prim = (int) (word & 15U);
+                    prim = (prim < PRIM_COUNT) ? prim : PRIM_NONE;
+                    vertices = 0U;
+                    break;
+                case 0x20U: ctx.color_mask = (uint8_t) (word & 15U); break;
+                case 0x21U: prim = PRIM_NONE; break; /* END */
+                case 0x22U:
+                    if (stack_depth < CONTEXT_DEPTH)
+                    {
+                        stack[stack_depth++] = ctx;
+                    }
+                    break;
+                case 0x23U:
+                    if (stack_depth > 0U)
+                    {
+                        ctx = stack[--stack_depth];
+                    }
+                    break;
+                case 0x24U:
+                    if (call_depth > 0U)
+                    {
+                        pc = calls[--call_depth];
+                    }
+                    break;
+                case 0x26U: clear(word); break;
+                case 0x27U: ctx.vertex_frac = (uint8_t) (word & 7U); break;
+                case 0x28U:
+                    p_handle->stride = (p_handle->stride & 0x3FFU) | (((word >> 2U) & 3U) << 10U);
+                    p_handle->layout_height = (p_handle->layout_height & 0x1FFU) | ((word & 3U) << 9U);
+                    break;
+                case 0x29U:
+                    p_handle->width = (p_handle->width & 0x1FFU) | (((word >> 2U) & 3U) << 9U);
+                    p_handle->height = (p_handle->height & 0x1FFU) | ((word & 3U) << 9U);
+                    break;
+                case 0x2AU: ctx.palette = word & 0x3FFFFFUL; break;
+                case 0x2BU: ctx.translate_x = sign_extend(word, 17U); break;
+                case 0x2CU: ctx.translate_y = sign_extend(word, 17U); break;
+                case 0x2DU: break; /* NOP */
+                case 0x2EU: p_handle->ext_format = word & 0xFFFFU; break;
+                default: stats.unsupported++; break;
+            }
+        }
+
+        if ((0 == vertex) || (PRIM_NONE == prim))
+        {
+            continue;
+        }
+
+        switch (prim)
+        {
+            case PRIM_BITMAPS:
+                stats.primitives[prim]++;
+                draw_bitmap(vx, vy, vertex_handle, vertex_cell);
+                break;
+            case PRIM_POINTS:
+                stats.primitives[prim]++;
+                draw_point(vx, vy);
+                break;
+            case PRIM_LINES:
+            case PRIM_RECTS:
+                if (1U == (vertices & 1U))
+                {
+                    stats.primitives[prim]++;
+                    if (PRIM_LINES == prim)
+                    {
+                        draw_line(prim, last_x, last_y, vx, vy);
+                    }
+                    else
+                    {
+                        draw_rect(last_x, last_y, vx, vy);
+                    }
+                }
+                break;
+            default: /* strips */
+                if (vertices > 0U)
+                {
+                    stats.primitives[prim]++;
+                    if (PRIM_LINE_STRIP == prim)
+                    {
+                        draw_line(prim, last_x, last_y, vx, vy);
+                    }
+                    else
+                    {
+                        draw_edge(prim, last_x, last_y, vx, vy);
+                    }
+                }
+                break;
+        }
+        last_x = vx;
+        last_y = vy;
+        vertices++;
+    }
+}
+
+static int write_png(const char *p_path, const image_t *p_image)
+{
+    uint32_t const row = (p_image->width * 3U) + 1U;
+    uLongf packed_size = compressBound(row * p_image->height);
+    uint8_t *p_raw = malloc((size_t) row * p_image->height);
+    uint8_t *p_packed = malloc(packed_size);
+    uint8_t header[13U];
+    FILE *p_file;
+
+    if ((NULL == p_raw) || (NULL == p_packed))
+    {
+        return (-1);
+    }
+
+    for (uint32_t y = 0U; y < p_image->height; y++)
+    {
+        p_raw[y * row] = 0U;
+        for (uint32_t x = 0U; x < p_image->width; x++)
+        {
+            memcpy(&p_raw[(y * row) + 1U + (x * 3U)], &p_image->p_rgba[((y * p_image->width) + x) * 4U], 3U);
+        }
+    }
+    compress2(p_packed, &packed_size, p_raw, row * p_image->height, Z_BEST_SPEED);
+
+    p_file = fopen(p_path, "wb");
+    if (NULL == p_file)
+    {
+        return (-1);
+    }
+
+    header[0U] = (uint8_t) (p_image->width >> 24U);
+    header[1U] = (uint8_t) (p_image->width >> 16U);
+    header[2U] = (uint8_t) (p_image->width >> 8U);
+    header[3U] = (uint8_t) p_image->width;
+    header[4U] = (uint8_t) (p_image->height >> 24U);
+    header[5U] = (uint8_t) (p_image->height >> 16U);
+    header[6U] = (uint8_t) (p_image->height >> 8U);
+    header[7U] = (uint8_t) p_image->height;
+    header[8U] = 8U;  /* bit depth */
+    header[9U] = 2U;  /* RGB */
+    header[10U] = 0U;
+    header[11U] = 0U;
+    header[12U] = 0U;
+
+    fwrite("\x89PNG\r\n\x1A\n", 1U, 8U, p_file);
+    {
+        const struct
+        {
+            const char *p_type;
+            const uint8_t *p_data;
+            uint32_t len;
+        } chunks[3U] = {{"IHDR", header, 13U}, {"IDAT", p_packed, (uint32_t) packed_size}, {"IEND", NULL, 0U}};
+
+        for (uint32_t index = 0U; index < 3U; index++)
+        {
+            uint8_t bytes[4U];
+            uLong crc = crc32(0L, (const Bytef *) chunks[index].p_type, 4U);
+
+            bytes[0U] = (uint8_t) (chunks[index].len >> 24U);
+            bytes[1U] = (uint8_t) (chunks[index].len >> 16U);
+            bytes[2U] = (uint8_t) (chunks[index].len >> 8U);
+            bytes[3U] = (uint8_t) chunks[index].len;
+            fwrite(bytes, 1U, 4U, p_file);
+            fwrite(chunks[index].p_type, 1U, 4U, p_file);
+            if (chunks[index].len != 0U)
+            {
+                fwrite(chunks[index].p_data, 1U, chunks[index].len, p_file);
+                crc = crc32(crc, chunks[index].p_data, chunks[index].len);
+            }
+            bytes[0U] = (uint8_t) (crc >> 24U);
+            bytes[1U] = (uint8_t) (crc >> 16U);
+            bytes[2U] = (uint8_t) (crc >> 8U);
+            bytes[3U] = (uint8_t) crc;
+            fwrite(bytes, 1U, 4U, p_file);
+        }
+    }
+    fclose(p_file);
+    free(p_raw);
+    free(p_packed);
+    return (0);
+}
+
+/* reads 8 bit RGB and RGBA PNG files as written by write_png() or most other programs */
+static int read_png(const char *p_path, image_t *p_image)
+{
+    FILE *p_file = fopen(p_path, "rb");
+    uint8_t *p_idat = NULL;
+    uint32_t idat_size = 0U;
+    uint8_t chunk_header[8U];
+    uint8_t signature[8U];
+    uint32_t channels = 0U;
+    uint32_t row;
+    uLongf raw_size;
+    uint8_t *p_raw;
+
+    if ((NULL == p_file) || (fread(signature, 1U, 8U, p_file) != 8U) || (memcmp(signature, "\x89PNG", 4U) != 0))
+    {
+        return (-1);
+    }
+
+    while (8U == fread(chunk_header, 1U, 8U, p_file))
+    {
+        uint32_t const len = get32be(chunk_header);
+        uint8_t *p_data = malloc((size_t) len + 4U);
+
+        if ((NULL == p_data) || (fread(p_data, 1U, (size_t) len + 4U, p_file) != ((size_t) len + 4U)))
+        {
+            free(p_data);
+            break;
+        }
+        if (0 == memcmp(&chunk_header[4U], "IHDR", 4U))
+        {
+            p_image->width = get32be(p_data);
+            p_image->height = get32be(&p_data[4U]);
+            channels = (2U == p_data[9U]) ? 3U : ((6U == p_data[9U]) ? 4U : 0U);
+            if ((p_data[8U] != 8U) || (p_data[12U] != 0U))
+            {
+                channels = 0U;
+            }
+        }
+        else if (0 == memcmp(&chunk_header[4U], "IDAT", 4U))
+        {
+            uint8_t *p_new = realloc(p_idat, idat_size + len);
+
+            if (p_new != NULL)
+            {
+                p_idat = p_new;
+                memcpy(&p_idat[idat_size], p_data, len);
+                idat_size += len;
+            }
+        }
+        free(p_data);
+    }
+    fclose(p_file);
+
+    if ((0U == channels) || (NULL == p_idat))
+    {
+        free(p_idat);
+        fprintf(stderr, "%s: only 8 bit RGB or RGBA, not interlaced\n", p_path);
+        return (-1);
+    }
+
+    row = (p_image->width * channels) + 1U;
+    raw_size = (uLongf) row * p_image->height;
+    p_raw = malloc(raw_size);
+    p_image->p_rgba = malloc((size_t) p_image->width * p_image->height * 4U);
+    if ((NULL == p_raw) || (NULL == p_image->p_rgba) || (uncompress(p_raw, &raw_size, p_idat, idat_size) != Z_OK))
+    {
+        free(p_idat);
+        return (-1);
+    }
+    free(p_idat);
+
+    for (uint32_t y = 0U; y < p_image->height; y++)
+    {
+        uint8_t *p_row = &p_raw[(y * row) + 1U];
+        const uint8_t *p_prev = (y > 0U) ? &p_raw[((y - 1U) * row) + 1U] : NULL;
+
+        for (uint32_t x = 0U; x < (row - 1U); x++)
+        {
+            int const left = (x >= channels) ? p_row[x - channels] : 0;
+            int const up = (p_prev != NULL) ? p_prev[x] : 0;
+            int const up_left = ((p_prev != NULL) && (x >= channels)) ? p_prev[x - channels] : 0;
+            int const estimate = left + up - up_left;
+            int predictor;
+
+            switch (p_row[-1])
+            {
+                case 1U: predictor = left; break;
+                case 2U: predictor = up; break;
+                case 3U: predictor = (left + up) / 2; break;
+                case 4U:
+                    predictor = ((abs(estimate - left) <= abs(estimate - up)) &&
+                                 (abs(estimate - left) <= abs(estimate - up_left))) ? left :
+                                ((abs(estimate - up) <= abs(estimate - up_left)) ? up : up_left);
+                    break;
+                default: predictor = 0; break;
+            }
+            p_row[x] = (uint8_t) (p_row[x] + predictor);
+        }
+        for (uint32_t x = 0U; x < p_image->width; x++)
+        {
+            uint8_t *p_pixel = &p_image->p_rgba[((y * p_image->width) + x) * 4U];
+
+            memcpy(p_pixel, &p_row[x * channels], 3U);
+            p_pixel[3U] = 255U;
+        }
+    }
+    free(p_raw);
+    return (0);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *p_frame = NULL;
+    const char *p_output = NULL;
+    const char *p_golden = NULL;
+    const char *p_diff = NULL;
+    uint32_t tolerance = 0U;
+    uint8_t header[HEADER_SIZE];
+    uint32_t not_drawn;
+    uint64_t total = 0U;
+    int ret = EXIT_SUCCESS;
+    FILE *p_file;
+
+    for (int arg = 1; arg < argc; arg++)
+    {
+        if ((0 == strcmp(argv[arg], "-o")) && ((arg + 1) < argc))
+        {
+            p_output = argv[++arg];
+        }
+        else if ((0 == strcmp(argv[arg], "-c")) && ((arg + 1) < argc))
+        {
+            p_golden = argv[++arg];
+        }
+        else if ((0 == strcmp(argv[arg], "-d")) && ((arg + 1) < argc))
+        {
+            p_diff = argv[++arg];
+        }
+        else if ((0 == strcmp(argv[arg], "-t")) && ((arg + 1) < argc))
+        {
+            tolerance = (uint32_t) strtoul(argv[++arg], NULL, 0);
+        }
+        else
+        {
+            p_frame = argv[arg];
+        }
+    }
+
+    if (NULL == p_frame)
+    {
+        fprintf(stderr, "usage: %s [-o frame.png] [-c golden.png] [-t tolerance] [-d diff.png] frame.evf\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    p_ram_g = malloc(RAM_G_SIZE);
+    p_file = fopen(p_frame, "rb");
+    if ((NULL == p_ram_g) || (NULL == p_file) || (fread(header, 1U, HEADER_SIZE, p_file) != HEADER_SIZE) ||
+        (memcmp(header, "EVEFRAME", 8U) != 0) || (fread(ram_dl, 1U, RAM_DL_SIZE, p_file) != RAM_DL_SIZE) ||
+        (fread(p_ram_g, 1U, RAM_G_SIZE, p_file) != RAM_G_SIZE))
+    {
+        fprintf(stderr, "%s: not a frame file\n", p_frame);
+        return (EXIT_FAILURE);
+    }
+    fclose(p_file);
+
+    screen.width = get32(&header[12U]) & 0xFFFU;
+    screen.height = get32(&header[16U]) & 0xFFFU;
+    macros[0U] = get32(&header[20U]);
+    macros[1U] = get32(&header[24U]);
+    not_drawn = get32(&header[28U]);
+    if ((0U == screen.width) || (0U == screen.height))
+    {
+        screen.width = 800U;
+        screen.height = 480U;
+    }
+
+    screen.p_rgba = calloc((size_t) screen.width * screen.height, 4U);
+    p_stencil = calloc((size_t) screen.width * screen.height, 1U);
+    if ((NULL == screen.p_rgba) || (NULL == p_stencil))
+    {
+        return (EXIT_FAILURE);
+    }
+
+    execute();
+
+    printf("%s: %lux%lu, %lu display list words", p_frame, (unsigned long) screen.width,
+           (unsigned long) screen.height, (unsigned long) stats.words);
+    if ((not_drawn != 0U) || (stats.unsupported != 0U))
+    {
+        printf(", not drawn: %lu coprocessor commands, %lu display list words", (unsigned long) not_drawn,
+               (unsigned long) stats.unsupported);
+    }
+    printf("\n%-14s %10s %12s\n", "primitive", "vertices", "fragments");
+    for (int prim = PRIM_BITMAPS; prim < PRIM_COUNT; prim++)
+    {
+        if (stats.primitives[prim] != 0U)
+        {
+            printf("%-14s %10lu %12llu\n", prim_names[prim], (unsigned long) stats.primitives[prim],
+                   (unsigned long long) stats.fragments[prim]);
+        }
+        total += stats.fragments[prim];
+    }
+    printf("fragments: %llu, overdraw: %.2f, bitmap bytes read: %llu\n", (unsigned long long) total,
+           (double) total / ((double) screen.width * screen.height), (unsigned long long) (stats.texel_bits / 8U));
+
+    if ((p_output != NULL) && (write_png(p_output, &screen) != 0))
+    {
+        fprintf(stderr, "%s: could not write\n", p_output);
+        ret = EXIT_FAILURE;
+    }
+
+    if (p_golden != NULL)
+    {
+        image_t golden = {0U, 0U, NULL};
+        uint32_t differ = 0U;
+        uint32_t worst = 0U;
+
+        if ((read_png(p_golden, &golden) != 0) || (golden.width != screen.width) || (golden.height != screen.height))
+        {
+            fprintf(stderr, "%s: could not read or the size does not match\n", p_golden);
+            return (EXIT_FAILURE);
+        }
+
+        for (uint32_t index = 0U; index < (screen.width * screen.height); index++)
+        {
+            uint32_t largest = 0U;
+
+            for (uint32_t channel = 0U; channel < 3U; channel++)
+            {
+                uint32_t const delta = (uint32_t) abs((int) screen.p_rgba[(index * 4U) + channel] -
+                                                      (int) golden.p_rgba[(index * 4U) + channel]);
+
+                largest = (delta > largest) ? delta : largest;
+            }
+            worst = (largest > worst) ? largest : worst;
+            if (largest > tolerance)
+            {
+                differ++;
+                memcpy(&golden.p_rgba[index * 4U], (const uint8_t []) {255U, 0U, 0U, 255U}, 4U);
+            }
+            else
+            {
+                golden.p_rgba[index * 4U] /= 4U; /* dimmed where it matches */
+                golden.p_rgba[(index * 4U) + 1U] /= 4U;
+                golden.p_rgba[(index * 4U) + 2U] /= 4U;
+            }
+        }
+
+        printf("%s: %lu pixels differ by more than %lu, largest difference %lu\n", p_golden,
+               (unsigned long) differ, (unsigned long) tolerance, (unsigned long) worst);
+        if ((p_diff != NULL) && (differ != 0U))
+        {
+            (void) write_png(p_diff, &golden);
+        }
+        if (differ != 0U)
+        {
+            ret = 1;
+        }
+        free(golden.p_rgba);
+    }
+
+    free(screen.p_rgba);
+    free(p_stencil);
+    free(p_ram_g);
+    return (ret);
+}
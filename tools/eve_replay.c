@@ -0,0 +1,365 @@
+/*
+@file    eve_replay.c
+@brief   send a capture file recorded with EVE_CAPTURE again and report the throughput
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+The capture is sent thru the Linux target of the library, so the same capture can be used
+to compare SPI clock settings on real hardware with spidev or transport changes with the
+simulator stand-in tools/eve_sim_socket.c.
+The format of the capture file is described in src/EVE_target/EVE_target_Linux_spidev.h.
+
+Reads are sent as reads, every byte read is compared to the recorded value and the
+differing bytes are counted, some of these are expected, for example for REG_CMD_READ.
+When the capture has a read of REG_CMDB_SPACE that returned 0xffc, the application
+was waiting for the coprocessor at this point, so the replay waits for it as well
+unless -n is given.
+
+Build with the target of the library, a display needs to be selected for EVE_config.h but is not used:
+gcc -std=c99 -O2 -DEVE_RVT50H -DEVE_SIM_SOCKET=\"/tmp/eve_sim.sock\" -I../src -o eve_replay eve_replay.c ../src/EVE_commands.c ../src/EVE_target.c
+or without -DEVE_SIM_SOCKET to use spidev.
+
+./eve_replay [-i] [-n] [-t] [-s speed] capture.bin
+-i: run EVE_init() before the replay, for captures that were started after EVE_init()
+-n: do not wait for the coprocessor
+-t: keep the recorded timing
+-s: set the SPI clock in Hz after EVE_init()
+
+@section History
+
+5.0
+- initial version
+- fix: capture version 2, all bytes of a read are replayed as reads and compared
+
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "EVE_commands.h"
+
+#define CAPTURE_FLAG_KEEP_CS 0x01U
+#define CAPTURE_FLAG_REPLY 0x02U
+#define CAPTURE_FLAG_PDN 0x04U
+#define CAPTURE_VERSION 2U
+
+static struct
+{
+    uint64_t records;
+    uint64_t windows;
+    uint64_t bytes;
+    uint64_t reads;
+    uint64_t read_mismatches;
+    uint64_t frames;
+    uint64_t waits;
+} stats;
+
+static int read_varint(FILE *p_file, uint32_t *p_value)
+{
+    uint32_t value = 0U;
+    uint8_t shift = 0U;
+    int data;
+
+    do
+    {
+        data = fgetc(p_file);
+        if ((EOF == data) || (shift > 28U))
+        {
+            return (-1);
+        }
+        value |= ((uint32_t) (data & 0x7F)) << shift;
+        shift += 7U;
+    } while ((data & 0x80) != 0);
+
+    *p_value = value;
+    return (0);
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9));
+}
+
+static void wait_us(uint32_t delay)
+{
+    struct timespec ts;
+
+    ts.tv_sec = (time_t) (delay / 1000000UL);
+    ts.tv_nsec = ((long) (delay % 1000000UL)) * 1000L;
+    (void) nanosleep(&ts, NULL);
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t data[1UL << 16U];
+    static uint8_t reply[1UL << 16U];
+    static uint8_t received[1UL << 16U];
+    int run_init = 0;
+    int sync = 1;
+    int timing = 0;
+    uint32_t speed = 0U;
+    int option;
+    FILE *p_file;
+    uint8_t header[8U];
+
+    /* state of the current chip-select window */
+    uint8_t in_window = 0U;
+    uint32_t window_count = 0U;
+    uint32_t window_address = 0U;
+    uint8_t window_type = 0U;
+    uint32_t window_word = 0U;
+    uint32_t window_read = 0U;
+    uint32_t window_read_count = 0U;
+    double start;
+    double elapsed;
+
+    while ((option = getopt(argc, argv, "ints:")) != -1)
+    {
+        switch (option)
+        {
+            case 'i':
+                run_init = 1;
+                break;
+            case 'n':
+                sync = 0;
+                break;
+            case 't':
+                timing = 1;
+                break;
+            case 's':
+                speed = (uint32_t) strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-i] [-n] [-t] [-s speed] capture.bin\n", argv[0]);
+                return (EXIT_FAILURE);
+        }
+    }
+
+    if (optind >= argc)
+    {
+        fprintf(stderr, "usage: %s [-i] [-n] [-t] [-s speed] capture.bin\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    p_file = fopen(argv[optind], "rb");
+    if ((NULL == p_file) || (fread(header, 1U, sizeof(header), p_file) != sizeof(header)) ||
+        (memcmp(header, "EVECAP", 6U) != 0) || (header[6U] != CAPTURE_VERSION))
+    {
+        fprintf(stderr, "%s: not a capture file\n", argv[optind]);
+        return (EXIT_FAILURE);
+    }
+
+    if (EVE_init_spi() != E_OK)
+    {
+        fprintf(stderr, "could not open the SPI device or the simulator socket\n");
+        return (EXIT_FAILURE);
+    }
+
+    if (run_init != 0)
+    {
+        if (EVE_init() != E_OK)
+        {
+            fprintf(stderr, "EVE_init() failed\n");
+            return (EXIT_FAILURE);
+        }
+    }
+
+    if (speed != 0U)
+    {
+        EVE_linux_set_speed(speed);
+    }
+
+    start = now();
+
+    for (;;)
+    {
+        uint32_t delay;
+        uint32_t len;
+        uint32_t reply_len = 0U;
+        uint32_t head;
+        int flags;
+
+        if (read_varint(p_file, &delay) != 0)
+        {
+            break;
+        }
+        flags = fgetc(p_file);
+        if ((EOF == flags) || (read_varint(p_file, &len) != 0))
+        {
+            break;
+        }
+
+        if (timing != 0)
+        {
+            wait_us(delay);
+        }
+
+        stats.records++;
+
+        if ((((uint32_t) flags) & CAPTURE_FLAG_PDN) != 0U)
+        {
+            if (0U == len)
+            {
+                EVE_pdn_set();
+            }
+            else
+            {
+                EVE_pdn_clear();
+            }
+            continue;
+        }
+
+        if ((len > sizeof(data)) || (fread(data, 1U, len, p_file) != len))
+        {
+            break;
+        }
+
+        if ((((uint32_t) flags) & CAPTURE_FLAG_REPLY) != 0U)
+        {
+            if ((read_varint(p_file, &reply_len) != 0) || (reply_len > len) ||
+                (fread(reply, 1U, reply_len, p_file) != reply_len))
+            {
+                break;
+            }
+        }
+        head = len - reply_len; /* the bytes read are the last ones of the transfer */
+
+        if (0U == in_window)
+        {
+            EVE_cs_set();
+            in_window = 1U;
+            window_count = 0U;
+            window_address = 0U;
+            window_read = 0U;
+            window_read_count = 0U;
+        }
+
+        for (uint32_t index = 0U; index < head; index++)
+        {
+            spi_transmit(data[index]);
+        }
+
+        if (reply_len != 0U)
+        {
+            /* a transfer that released chip-select is replayed as one, the others byte by byte to keep chip-select */
+            if (0U == (((uint32_t) flags) & CAPTURE_FLAG_KEEP_CS))
+            {
+                spi_receive_buffer(received, reply_len);
+            }
+            else
+            {
+                for (uint32_t index = 0U; index < reply_len; index++)
+                {
+                    received[index] = spi_receive(data[head + index]);
+                }
+            }
+
+            for (uint32_t index = 0U; index < reply_len; index++)
+            {
+                if (received[index] != reply[index])
+                {
+                    stats.read_mismatches++;
+                }
+                if (window_read_count < 4U)
+                {
+                    window_read |= ((uint32_t) reply[index]) << (8U * window_read_count);
+                    window_read_count++;
+                }
+            }
+            stats.reads += reply_len;
+        }
+
+        for (uint32_t index = 0U; index < len; index++)
+        {
+            uint8_t value = data[index];
+
+            if (window_count < 3U)
+            {
+                window_address = (window_address << 8U) | value;
+                if (2U == window_count)
+                {
+                    window_type = (uint8_t) (window_address >> 22U);
+                    window_address &= 0x3FFFFFUL;
+                    window_word = 0U;
+                }
+            }
+            else if ((2U == window_type) && (REG_CMDB_WRITE == window_address))
+            {
+                window_word = (window_word >> 8U) | (((uint32_t) value) << 24U);
+                if (0U == ((window_count - 3U + 1U) & 3U))
+                {
+                    if (CMD_SWAP == window_word)
+                    {
+                        stats.frames++;
+                    }
+                }
+            }
+            window_count++;
+        }
+        stats.bytes += len;
+
+        if (0U == (((uint32_t) flags) & CAPTURE_FLAG_KEEP_CS))
+        {
+            EVE_cs_clear();
+            in_window = 0U;
+            stats.windows++;
+
+            /* the application waited for the coprocessor here */
+            if ((sync != 0) && (0U == window_type) && (REG_CMDB_SPACE == window_address) &&
+                (window_read_count >= 2U) && (0xFFCUL == (window_read & 0xFFFFUL)))
+            {
+                while (EVE_busy() != E_OK)
+                {
+                    stats.waits++;
+                }
+            }
+        }
+    }
+
+    elapsed = now() - start;
+    fclose(p_file);
+
+    printf("records: %llu, chip-select windows: %llu, bytes: %llu\n", (unsigned long long) stats.records,
+           (unsigned long long) stats.windows, (unsigned long long) stats.bytes);
+    printf("reads: %llu, differing from the capture: %llu, extra busy polls: %llu\n", (unsigned long long) stats.reads,
+           (unsigned long long) stats.read_mismatches, (unsigned long long) stats.waits);
+    printf("frames (CMD_SWAP): %llu\n", (unsigned long long) stats.frames);
+    printf("elapsed: %.3f s, %.0f bytes/s, %.1f frames/s\n", elapsed, (double) stats.bytes / elapsed,
+           (double) stats.frames / elapsed);
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,787 @@
+/*
+@file    eve_sim_socket.c
+@brief   stand-in for a real EVE on the other end of the Unix socket of the Linux spidev target
+@version 5.0
+@date    2026-10-19
+@author  Rudolph Riedel
+
+@section LICENSE
+
+MIT License
+
+Copyright (c) 2016-2026 Rudolph Riedel
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+@section info
+
+This is not an emulator, it only models what is needed to run the library and to measure the host side:
+- the memory map with REG_ID, REG_CPURESET and the chip-id set up as after a reset
+- host commands, memory reads and memory writes with address auto-increment
+- writes to REG_CMDB_WRITE and REG_CMD_WRITE go to RAM_CMD and the coprocessor is always done instantly,
+  so REG_CMD_READ follows REG_CMD_WRITE and REG_CMDB_SPACE always is 0xffc
+- a value written to REG_TOUCH_RAW_XY is put through REG_TOUCH_TRANSFORM_A...F into REG_TOUCH_SCREEN_XY,
+  as the reference for src/EVE_calibrate.c
+
+When the client disconnects a report is printed with the number of chip-select windows,
+the bytes transferred, the coprocessor bytes, the number of CMD_SWAP seen and the
+time the same traffic would need on a SPI bus with the given clock.
+
+With a frame prefix every display list is written to a file when it is swapped in, for
+tools/eve_render.c to compare it against a golden image. For this the coprocessor
+commands that build the display list are executed: display list words, CMD_DLSTART,
+CMD_SWAP, CMD_APPEND, CMD_SETBITMAP, CMD_MEMWRITE, CMD_MEMSET, CMD_MEMZERO, CMD_MEMCPY,
+CMD_INFLATE, CMD_INFLATE2 and the matrix commands. The arguments of all other commands
+are skipped and these are counted as not drawn, a frame with widgets is not complete.
+A frame file is "EVEFRAME", version, REG_HSIZE, REG_VSIZE, REG_MACRO_0, REG_MACRO_1, the number
+of commands not drawn, all 32 bit little endian, followed by RAM_DL and RAM_G.
+
+Build and run:
+gcc -std=c99 -Wall -Wextra -O2 -o eve_sim_socket eve_sim_socket.c -lz -lm
+./eve_sim_socket [socket path] [SPI clock in Hz] [frame prefix]
+
+Build the application with -DEVE_SIM_SOCKET=\"/tmp/eve_sim.sock\" to connect to it.
+
+@section History
+
+5.0
+- initial version
+- added the display list interpreter for the coprocessor and the frame files
+- added the touch transform from REG_TOUCH_RAW_XY to REG_TOUCH_SCREEN_XY
+
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <zlib.h>
+
+#define SIM_FRAME_TRANSFER 0x54U /* 'T' */
+#define SIM_FRAME_PDN 0x50U /* 'P' */
+#define SIM_FLAG_KEEP_CS 0x01U
+#define SIM_FLAG_REPLY 0x02U
+
+#define MEM_SIZE 0x400000UL
+#define RAM_CMD 0x308000UL
+#define RAM_CHIPID 0x0C0000UL
+#define REG_ID 0x302000UL
+#define REG_CPURESET 0x302020UL
+#define REG_CMD_READ 0x3020F8UL
+#define REG_CMD_WRITE 0x3020FCUL
+#define REG_CMDB_SPACE 0x302574UL
+#define REG_CMDB_WRITE 0x302578UL
+#define CMD_SWAP 0xFFFFFF01UL
+#define CMD_DLSTART 0xFFFFFF00UL
+#define RAM_DL 0x300000UL
+#define RAM_DL_SIZE 8192UL
+#define RAM_G_SIZE 0x100000UL
+#define REG_HSIZE 0x302034UL
+#define REG_VSIZE 0x302048UL
+#define REG_DLSWAP 0x302054UL
+#define REG_MACRO_0 0x3020D8UL
+#define REG_MACRO_1 0x3020DCUL
+#define REG_CMD_DL 0x302100UL
+#define REG_TOUCH_RAW_XY 0x30211CUL
+#define REG_TOUCH_SCREEN_XY 0x302124UL
+#define REG_TOUCH_TRANSFORM_A 0x302150UL
+
+#define ARGS_STRING 0x80U /* the arguments are followed by a zero terminated string */
+#define ARGS_UNKNOWN 0xFFU /* followed by data of unknown length, the FIFO can not be parsed until CMD_DLSTART */
+
+#define FRAME_MAX (1UL << 20U)
+
+enum
+{
+    STATE_HEADER = 0,
+    STATE_DUMMY,
+    STATE_READ,
+    STATE_WRITE
+};
+
+static uint8_t memory[MEM_SIZE];
+static uint8_t frame[FRAME_MAX];
+static uint8_t reply[FRAME_MAX];
+
+static struct
+{
+    int state;
+    uint32_t count;
+    uint32_t address;
+} window;
+
+/* number of argument words of the coprocessor commands 0xFFFFFF00 to 0xFFFFFF70 */
+static const uint8_t command_args[0x71U] =
+{
+    0U, 0U, 1U, ARGS_UNKNOWN, ARGS_UNKNOWN, ARGS_UNKNOWN, ARGS_UNKNOWN, ARGS_UNKNOWN, /* 0x00 */
+    ARGS_UNKNOWN, 1U, 1U, 4U, ARGS_STRING | 2U, ARGS_STRING | 3U, ARGS_STRING | 3U, 4U, /* 0x08 */
+    4U, 4U, ARGS_STRING | 3U, 4U, 4U, 1U, 2U, 0U, /* 0x10 */
+    3U, 2U, 2U, 3U, 2U, 3U, 2U, 1U, /* 0x18 */
+    ARGS_UNKNOWN, 13U, 1U, 1U, 2U, 3U, 0U, 2U, /* 0x20 */
+    2U, 1U, 0U, 2U, 3U, 3U, 3U, 0U, /* 0x28 */
+    4U, 0U, 0U, 6U, 1U, ARGS_UNKNOWN, 1U, 4U, /* 0x30 */
+    1U, 2U, 1U, 3U, 1U, ARGS_UNKNOWN, ARGS_UNKNOWN, 2U, /* 0x38 */
+    0U, 2U, 0U, 3U, 0U, 2U, 3U, 3U, /* 0x40 */
+    0U, 0U, 1U, 0U, 1U, 2U, 1U, 0U, /* 0x48 */
+    2U, 4U, 0U, 3U, 1U, 2U, 1U, 4U, /* 0x50 */
+    1U, 2U, 3U, ARGS_UNKNOWN, ARGS_UNKNOWN, ARGS_UNKNOWN, 1U, 0U, /* 0x58 */
+    3U, 0U, 1U, 1U, 5U, 1U, 0U, 1U, /* 0x60 */
+    1U, 0U, 3U, 3U, 2U, 3U, 3U, 2U, /* 0x68 */
+    3U /* 0x70 */
+};
+
+/* bits per pixel of the bitmap formats 0 to 17 for CMD_SETBITMAP */
+static const uint8_t format_bits[18U] = {16U, 1U, 4U, 8U, 8U, 8U, 16U, 16U, 8U, 8U, 8U, 8U, 0U, 0U, 8U, 8U, 8U, 2U};
+
+static struct
+{
+    uint32_t cmd;         /* command that collects arguments, 0 for none */
+    uint32_t args[16U];
+    uint32_t count;       /* arguments received */
+    uint32_t needed;      /* arguments expected */
+    uint8_t string;       /* skip words until one with a zero byte after the arguments */
+    uint8_t lost;         /* skip everything until CMD_DLSTART */
+    uint32_t data_left;   /* bytes of data following the arguments */
+    uint32_t data_address;
+    uint8_t data_write;   /* 1: the data goes to memory, 0: it is skipped */
+    uint8_t inflating;
+    z_stream zlib;
+    double matrix[6U];    /* a b c d e f of the coprocessor bitmap matrix */
+    uint32_t not_drawn;
+    uint32_t frame_number;
+    const char *p_prefix;
+} copro;
+
+static struct
+{
+    uint64_t windows;
+    uint64_t frames;
+    uint64_t bytes;
+    uint64_t cmd_bytes;
+    uint64_t swaps;
+    uint32_t cmd_word;
+    uint32_t cmd_word_bytes;
+} stats;
+
+static void put32(uint32_t address, uint32_t value)
+{
+    memory[address] = (uint8_t) value;
+    memory[address + 1U] = (uint8_t) (value >> 8U);
+    memory[address + 2U] = (uint8_t) (value >> 16U);
+    memory[address + 3U] = (uint8_t) (value >> 24U);
+}
+
+static uint32_t get32(uint32_t address)
+{
+    return ((uint32_t) memory[address]) | (((uint32_t) memory[address + 1U]) << 8U) |
+           (((uint32_t) memory[address + 2U]) << 16U) | (((uint32_t) memory[address + 3U]) << 24U);
+}
+
+static void write_frame(void)
+{
+    char path[512U];
+    uint8_t header[36U];
+    FILE *p_file;
+
+    if (NULL == copro.p_prefix)
+    {
+        return;
+    }
+
+    snprintf(path, sizeof(path), "%s%05lu.evf", copro.p_prefix, (unsigned long) copro.frame_number);
+    copro.frame_number++;
+    memcpy(header, "EVEFRAME", 8U);
+    memcpy(&header[8U], (uint8_t []) {1U, 0U, 0U, 0U}, 4U);
+    memcpy(&header[12U], &memory[REG_HSIZE], 4U);
+    memcpy(&header[16U], &memory[REG_VSIZE], 4U);
+    memcpy(&header[20U], &memory[REG_MACRO_0], 4U);
+    memcpy(&header[24U], &memory[REG_MACRO_1], 4U);
+    header[28U] = (uint8_t) copro.not_drawn;
+    header[29U] = (uint8_t) (copro.not_drawn >> 8U);
+    header[30U] = (uint8_t) (copro.not_drawn >> 16U);
+    header[31U] = (uint8_t) (copro.not_drawn >> 24U);
+    memset(&header[32U], 0, 4U);
+
+    p_file = fopen(path, "wb");
+    if (p_file != NULL)
+    {
+        fwrite(header, 1U, sizeof(header), p_file);
+        fwrite(&memory[RAM_DL], 1U, RAM_DL_SIZE, p_file);
+        fwrite(memory, 1U, RAM_G_SIZE, p_file);
+        fclose(p_file);
+    }
+}
+
+static void dl_append(uint32_t word)
+{
+    uint32_t const offset = get32(REG_CMD_DL) & (RAM_DL_SIZE - 1U);
+
+    put32(RAM_DL + offset, word);
+    put32(REG_CMD_DL, (offset + 4U) & (RAM_DL_SIZE - 1U));
+}
+
+static void matrix_multiply(double a, double b, double c, double d, double e, double f)
+{
+    double *p_m = copro.matrix;
+    double const result[6U] =
+    {
+        (p_m[0U] * a) + (p_m[1U] * d), (p_m[0U] * b) + (p_m[1U] * e), (p_m[0U] * c) + (p_m[1U] * f) + p_m[2U],
+        (p_m[3U] * a) + (p_m[4U] * d), (p_m[3U] * b) + (p_m[4U] * e), (p_m[3U] * c) + (p_m[4U] * f) + p_m[5U]
+    };
+
+    memcpy(p_m, result, sizeof(result));
+}
+
+/* the inverse of the matrix is what the bitmap engine uses, in 8.8 and 16.8 fixed point */
+static void matrix_to_dl(void)
+{
+    double const *p_m = copro.matrix;
+    double const det = (p_m[0U] * p_m[4U]) - (p_m[1U] * p_m[3U]);
+    double inverse[6U] = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0};
+
+    if (det != 0.0)
+    {
+        inverse[0U] = p_m[4U] / det;
+        inverse[1U] = -p_m[1U] / det;
+        inverse[3U] = -p_m[3U] / det;
+        inverse[4U] = p_m[0U] / det;
+        inverse[2U] = -((inverse[0U] * p_m[2U]) + (inverse[1U] * p_m[5U]));
+        inverse[5U] = -((inverse[3U] * p_m[2U]) + (inverse[4U] * p_m[5U]));
+    }
+
+    for (uint32_t index = 0U; index < 6U; index++)
+    {
+        uint32_t const mask = ((2U == index) || (5U == index)) ? 0xFFFFFFUL : 0x1FFFFUL;
+        int32_t const value = (int32_t) (inverse[index] * 256.0);
+
+        dl_append(((0x15UL + index) << 24U) | ((uint32_t) value & mask));
+    }
+}
+
+static void setbitmap(uint32_t address, uint32_t format, uint32_t width, uint32_t height)
+{
+    uint32_t layout = format;
+    uint32_t stride;
+
+    if (format > 17U)
+    {
+        layout = 31U; /* GLFORMAT */
+        stride = ((width + 3U) / 4U) * 16U; /* not exact for ASTC, the renderer does not draw these */
+    }
+    else
+    {
+        stride = ((width * format_bits[format]) + 7U) / 8U;
+    }
+
+    dl_append(0x01000000UL | (address & 0xFFFFFFUL));
+    dl_append(0x07000000UL | (layout << 19U) | ((stride & 0x3FFU) << 9U) | (height & 0x1FFU));
+    dl_append(0x28000000UL | ((stride >> 10U) << 2U) | (height >> 9U));
+    dl_append(0x08000000UL | ((width & 0x1FFU) << 9U) | (height & 0x1FFU));
+    dl_append(0x29000000UL | ((width >> 9U) << 2U) | (height >> 9U));
+    if (31U == layout)
+    {
+        dl_append(0x2E000000UL | format);
+    }
+}
+
+/* a command with all its arguments */
+static void coprocessor_execute(void)
+{
+    uint32_t const *p_args = copro.args;
+
+    switch (copro.cmd & 0xFFU)
+    {
+        case 0x1AU: /* CMD_MEMWRITE */
+        case 0x45U: /* CMD_FLASHWRITE */
+        case 0x4CU: /* CMD_FLASHSPITX */
+            copro.data_address = p_args[0U] & (MEM_SIZE - 1U);
+            copro.data_left = (p_args[copro.needed - 1U] + 3U) & ~3UL;
+            copro.data_write = (0x1AU == (copro.cmd & 0xFFU)) ? 1U : 0U;
+            break;
+        case 0x1BU: /* CMD_MEMSET */
+            memset(&memory[p_args[0U] & (MEM_SIZE - 1U)], (int) p_args[1U], p_args[2U] & (RAM_G_SIZE - 1U));
+            break;
+        case 0x1CU: /* CMD_MEMZERO */
+            memset(&memory[p_args[0U] & (MEM_SIZE - 1U)], 0, p_args[1U] & (RAM_G_SIZE - 1U));
+            break;
+        case 0x1DU: /* CMD_MEMCPY */
+            memmove(&memory[p_args[0U] & (MEM_SIZE - 1U)], &memory[p_args[1U] & (MEM_SIZE - 1U)],
+                    p_args[2U] & (RAM_G_SIZE - 1U));
+            break;
+        case 0x1EU: /* CMD_APPEND */
+            for (uint32_t offset = 0U; offset < p_args[1U]; offset += 4U)
+            {
+                dl_append(get32((p_args[0U] + offset) & (MEM_SIZE - 4U)));
+            }
+            break;
+        case 0x24U: /* CMD_LOADIMAGE */
+        case 0x3AU: /* CMD_PLAYVIDEO */
+            if (0U == (p_args[copro.needed - 1U] & 0x50U)) /* neither OPT_MEDIAFIFO nor OPT_FLASH */
+            {
+                copro.lost = 1U;
+            }
+            copro.not_drawn++;
+            break;
+        case 0x22U: /* CMD_INFLATE */
+        case 0x50U: /* CMD_INFLATE2 */
+            if ((0x22U == (copro.cmd & 0xFFU)) || (0U == p_args[1U]))
+            {
+                memset(&copro.zlib, 0, sizeof(copro.zlib));
+                inflateInit(&copro.zlib);
+                copro.zlib.next_out = &memory[p_args[0U] & (RAM_G_SIZE - 1U)];
+                copro.zlib.avail_out = RAM_G_SIZE - (p_args[0U] & (RAM_G_SIZE - 1U));
+                copro.inflating = 1U;
+            }
+            break;
+        case 0x26U: /* CMD_LOADIDENTITY */
+            memcpy(copro.matrix, (double [6U]) {1.0, 0.0, 0.0, 0.0, 1.0, 0.0}, sizeof(copro.matrix));
+            break;
+        case 0x27U: /* CMD_TRANSLATE */
+            matrix_multiply(1.0, 0.0, (int32_t) p_args[0U] / 65536.0, 0.0, 1.0, (int32_t) p_args[1U] / 65536.0);
+            break;
+        case 0x28U: /* CMD_SCALE */
+            matrix_multiply((int32_t) p_args[0U] / 65536.0, 0.0, 0.0, 0.0, (int32_t) p_args[1U] / 65536.0, 0.0);
+            break;
+        case 0x29U: /* CMD_ROTATE */
+        {
+            double const angle = ((double) p_args[0U] / 65536.0) * 6.283185307179586;
+            double const sine = sin(angle);
+            double const cosine = cos(angle);
+
+            matrix_multiply(cosine, -sine, 0.0, sine, cosine, 0.0);
+            break;
+        }
+        case 0x2AU: /* CMD_SETMATRIX */
+            matrix_to_dl();
+            break;
+        case 0x43U: /* CMD_SETBITMAP */
+            setbitmap(p_args[0U], p_args[1U] & 0xFFFFU, p_args[1U] >> 16U, p_args[2U] & 0xFFFFU);
+            break;
+        case 0x09U: /* CMD_BGCOLOR */
+        case 0x0AU: /* CMD_FGCOLOR */
+        case 0x34U: /* CMD_GRADCOLOR */
+        case 0x2BU: /* CMD_SETFONT */
+        case 0x3BU: /* CMD_SETFONT2 */
+        case 0x3FU: /* CMD_ROMFONT */
+        case 0x38U: /* CMD_SETBASE */
+        case 0x39U: /* CMD_MEDIAFIFO */
+        case 0x42U: /* CMD_SYNC */
+        case 0x18U: /* CMD_MEMCRC */
+        case 0x19U: /* CMD_REGREAD */
+        case 0x23U: /* CMD_GETPTR */
+        case 0x25U: /* CMD_GETPROPS */
+        case 0x02U: /* CMD_INTERRUPT */
+        case 0x17U: /* CMD_STOP */
+        case 0x32U: /* CMD_COLDSTART */
+        case 0x33U: /* CMD_GETMATRIX */
+        case 0x36U: /* CMD_SETROTATE */
+        case 0x3CU: /* CMD_SETSCRATCH */
+            break;
+        default:
+            if ((copro.cmd & 0xFFU) >= 0x44U) /* flash, animation and other commands that do not draw */
+            {
+                break;
+            }
+            copro.not_drawn++;
+            break;
+    }
+}
+
+static void coprocessor_word(uint32_t word)
+{
+    if (copro.inflating != 0U)
+    {
+        uint8_t bytes[4U] = {(uint8_t) word, (uint8_t) (word >> 8U), (uint8_t) (word >> 16U), (uint8_t) (word >> 24U)};
+
+        copro.zlib.next_in = bytes;
+        copro.zlib.avail_in = 4U;
+        if (inflate(&copro.zlib, Z_NO_FLUSH) != Z_OK)
+        {
+            inflateEnd(&copro.zlib);
+            copro.inflating = 0U; /* the rest of the word is padding */
+        }
+    }
+    else if (copro.data_left != 0U)
+    {
+        if (copro.data_write != 0U)
+        {
+            put32(copro.data_address, word);
+            copro.data_address = (copro.data_address + 4U) & (MEM_SIZE - 4U);
+        }
+        copro.data_left -= 4U;
+    }
+    else if (copro.cmd != 0U)
+    {
+        if (copro.count < copro.needed)
+        {
+            copro.args[copro.count] = word;
+            copro.count++;
+            if ((copro.count == copro.needed) && (0U == copro.string))
+            {
+                coprocessor_execute();
+                copro.cmd = 0U;
+            }
+        }
+        else if (((word & 0xFF000000UL) == 0U) || ((word & 0xFF0000UL) == 0U) ||
+                 ((word & 0xFF00UL) == 0U) || ((word & 0xFFUL) == 0U))
+        {
+            coprocessor_execute(); /* the string ended */
+            copro.cmd = 0U;
+        }
+    }
+    else if (CMD_DLSTART == word)
+    {
+        put32(REG_CMD_DL, 0U);
+        copro.lost = 0U;
+        copro.not_drawn = 0U;
+    }
+    else if (copro.lost != 0U)
+    {
+        /* data of unknown length */
+    }
+    else if (CMD_SWAP == word)
+    {
+        write_frame();
+    }
+    else if ((word & 0xFFFFFF00UL) != 0xFFFFFF00UL)
+    {
+        dl_append(word);
+    }
+    else if ((word & 0xFFU) > 0x70U)
+    {
+        copro.lost = 1U;
+    }
+    else if (ARGS_UNKNOWN == command_args[word & 0xFFU])
+    {
+        copro.lost = 1U;
+    }
+    else
+    {
+        copro.cmd = word;
+        copro.count = 0U;
+        copro.needed = command_args[word & 0xFFU] & 0x7FU;
+        copro.string = command_args[word & 0xFFU] & ARGS_STRING;
+        if ((0U == copro.needed) && (0U == copro.string))
+        {
+            coprocessor_execute();
+            copro.cmd = 0U;
+        }
+    }
+}
+
+static void sim_reset(void)
+{
+    memset(memory, 0, sizeof(memory));
+    memory[REG_ID] = 0x7CU;
+    put32(RAM_CHIPID, 0x00011708UL); /* BT817 */
+    put32(REG_CMDB_SPACE, 0xFFCUL);
+    memset(&window, 0, sizeof(window));
+    if (copro.inflating != 0U)
+    {
+        inflateEnd(&copro.zlib);
+    }
+    {
+        const char *p_prefix = copro.p_prefix;
+        uint32_t frame_number = copro.frame_number;
+
+        memset(&copro, 0, sizeof(copro));
+        copro.p_prefix = p_prefix;
+        copro.frame_number = frame_number;
+        copro.matrix[0U] = 1.0;
+        copro.matrix[4U] = 1.0;
+    }
+}
+
+/* the coprocessor is done instantly */
+static void cmd_fifo_write(uint8_t data)
+{
+    uint32_t offset = get32(REG_CMD_WRITE) & 0xFFFUL;
+
+    memory[RAM_CMD + offset] = data;
+    offset = (offset + 1U) & 0xFFFUL;
+    put32(REG_CMD_WRITE, offset);
+    put32(REG_CMD_READ, offset);
+
+    stats.cmd_bytes++;
+    stats.cmd_word |= ((uint32_t) data) << (8U * stats.cmd_word_bytes);
+    stats.cmd_word_bytes++;
+    if (4U == stats.cmd_word_bytes)
+    {
+        if (CMD_SWAP == stats.cmd_word)
+        {
+            stats.swaps++;
+        }
+        coprocessor_word(stats.cmd_word);
+        stats.cmd_word = 0U;
+        stats.cmd_word_bytes = 0U;
+    }
+}
+
+/* the resistive touch engine: screen = (matrix * raw) / 65536 rounded down, 0x80008000 without a touch */
+static void touch_transform(void)
+{
+    uint32_t const raw = get32(REG_TOUCH_RAW_XY);
+    uint32_t screen = 0x80008000UL;
+
+    if (raw != 0xFFFFFFFFUL)
+    {
+        int64_t matrix[6U];
+        int64_t const raw_x = raw >> 16U;
+        int64_t const raw_y = raw & 0xFFFFU;
+
+        for (uint32_t index = 0U; index < 6U; index++)
+        {
+            matrix[index] = (int32_t) get32(REG_TOUCH_TRANSFORM_A + (index * 4U));
+        }
+        double const screen_x = floor((double) ((matrix[0U] * raw_x) + (matrix[1U] * raw_y) + matrix[2U]) / 65536.0);
+        double const screen_y = floor((double) ((matrix[3U] * raw_x) + (matrix[4U] * raw_y) + matrix[5U]) / 65536.0);
+
+        screen = (((uint32_t) (int64_t) screen_x) << 16U) | (((uint32_t) (int64_t) screen_y) & 0xFFFFU);
+    }
+    put32(REG_TOUCH_SCREEN_XY, screen);
+}
+
+static void memory_write(uint32_t address, uint8_t data)
+{
+    if ((address >= REG_CMDB_WRITE) && (address < (REG_CMDB_WRITE + 4U)))
+    {
+        cmd_fifo_write(data);
+    }
+    else
+    {
+        memory[address] = data;
+        if (address == (REG_CMD_WRITE + 3U))
+        {
+            put32(REG_CMD_READ, get32(REG_CMD_WRITE));
+        }
+        if (address == (REG_TOUCH_RAW_XY + 3U))
+        {
+            touch_transform();
+        }
+        if ((REG_DLSWAP == address) && (data != 0U)) /* display list written directly to RAM_DL */
+        {
+            copro.not_drawn = 0U;
+            write_frame();
+            memory[address] = 0U;
+        }
+    }
+}
+
+static uint8_t spi_byte(uint8_t mosi)
+{
+    uint8_t miso = 0U;
+
+    switch (window.state)
+    {
+        case STATE_HEADER:
+            window.address = (window.address << 8U) | mosi;
+            window.count++;
+            if (3U == window.count)
+            {
+                uint8_t type = (uint8_t) (window.address >> 22U);
+
+                window.address &= 0x3FFFFFUL;
+                if (2U == type)
+                {
+                    window.state = STATE_WRITE;
+                }
+                else if (0U == type)
+                {
+                    window.state = STATE_DUMMY;
+                }
+                else
+                {
+                    window.state = STATE_DUMMY; /* host command, anything after the three bytes is ignored */
+                    window.address = MEM_SIZE - 1U;
+                }
+            }
+            break;
+        case STATE_DUMMY:
+            window.state = STATE_READ;
+            break;
+        case STATE_READ:
+            miso = memory[window.address];
+            window.address = (window.address + 1U) & (MEM_SIZE - 1U);
+            break;
+        default: /* STATE_WRITE */
+            memory_write(window.address, mosi);
+            if ((window.address < REG_CMDB_WRITE) || (window.address >= (REG_CMDB_WRITE + 4U)))
+            {
+                window.address = (window.address + 1U) & (MEM_SIZE - 1U);
+            }
+            else
+            {
+                window.address = REG_CMDB_WRITE + ((window.address + 1U) & 3U);
+            }
+            break;
+    }
+    return (miso);
+}
+
+static int read_all(int fd, uint8_t *p_data, size_t len)
+{
+    size_t offset = 0U;
+
+    while (offset < len)
+    {
+        ssize_t result = read(fd, &p_data[offset], len - offset);
+
+        if (result <= 0)
+        {
+            if ((result < 0) && (EINTR == errno))
+            {
+                continue;
+            }
+            return (-1);
+        }
+        offset += (size_t) result;
+    }
+    return (0);
+}
+
+static int write_all(int fd, const uint8_t *p_data, size_t len)
+{
+    size_t offset = 0U;
+
+    while (offset < len)
+    {
+        ssize_t result = write(fd, &p_data[offset], len - offset);
+
+        if (result <= 0)
+        {
+            if ((result < 0) && (EINTR == errno))
+            {
+                continue;
+            }
+            return (-1);
+        }
+        offset += (size_t) result;
+    }
+    return (0);
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9));
+}
+
+static void serve(int fd, double spi_clock)
+{
+    uint8_t header[8U];
+    double start = now();
+    double elapsed;
+
+    memset(&stats, 0, sizeof(stats));
+
+    while (0 == read_all(fd, header, sizeof(header)))
+    {
+        uint32_t len = ((uint32_t) header[4U]) | (((uint32_t) header[5U]) << 8U) |
+                       (((uint32_t) header[6U]) << 16U) | (((uint32_t) header[7U]) << 24U);
+
+        if (SIM_FRAME_PDN == header[0U])
+        {
+            if (0U == header[1U])
+            {
+                sim_reset();
+            }
+            continue;
+        }
+
+        if ((len > FRAME_MAX) || (read_all(fd, frame, len) != 0))
+        {
+            break;
+        }
+
+        stats.frames++;
+        stats.bytes += len;
+        for (uint32_t index = 0U; index < len; index++)
+        {
+            reply[index] = spi_byte(frame[index]);
+        }
+
+        if ((header[1U] & SIM_FLAG_REPLY) != 0U)
+        {
+            if (write_all(fd, reply, len) != 0)
+            {
+                break;
+            }
+        }
+
+        if (0U == (header[1U] & SIM_FLAG_KEEP_CS))
+        {
+            stats.windows++;
+            memset(&window, 0, sizeof(window));
+        }
+    }
+
+    elapsed = now() - start;
+    printf("chip-select windows: %llu, frames: %llu\n", (unsigned long long) stats.windows, (unsigned long long) stats.frames);
+    printf("bytes: %llu, coprocessor bytes: %llu, CMD_SWAP: %llu\n", (unsigned long long) stats.bytes,
+           (unsigned long long) stats.cmd_bytes, (unsigned long long) stats.swaps);
+    printf("elapsed: %.3f s, %.0f bytes/s, %.0f frames/s\n", elapsed, (double) stats.bytes / elapsed,
+           (double) stats.frames / elapsed);
+    printf("SPI time at %.0f Hz: %.3f s\n", spi_clock, ((double) stats.bytes * 8.0) / spi_clock);
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *p_path = (argc > 1) ? argv[1] : "/tmp/eve_sim.sock";
+    double spi_clock = (argc > 2) ? strtod(argv[2], NULL) : 30000000.0;
+    copro.p_prefix = (argc > 3) ? argv[3] : NULL;
+    struct sockaddr_un address;
+    int listen_fd;
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, p_path, sizeof(address.sun_path) - 1U);
+    (void) unlink(p_path);
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ((listen_fd < 0) || (bind(listen_fd, (const struct sockaddr *) &address, sizeof(address)) != 0) ||
+        (listen(listen_fd, 1) != 0))
+    {
+        perror("eve_sim_socket");
+        return (EXIT_FAILURE);
+    }
+
+    printf("waiting for connections on %s\n", p_path);
+    fflush(stdout);
+    for (;;)
+    {
+        int fd = accept(listen_fd, NULL, NULL);
+
+        if (fd >= 0)
+        {
+            sim_reset();
+            serve(fd, spi_clock);
+            close(fd);
+        }
+    }
+}